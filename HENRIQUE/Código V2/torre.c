@@ -5,13 +5,27 @@
 #include "torre.h"
 #include "historico.h" // Inclui para usar as funções de histórico
 
+#ifdef _WIN32
+#include <windows.h> // Para ativar sequências ANSI no console
+#endif
+
+// Limpa a tela com sequências ANSI, sem criar um processo a cada redesenho.
+// No Windows ativa o modo de terminal virtual do console; se não for possível, usa "cls".
 void clear() {
 #ifdef _WIN32
-    system("cls");
-#else
-    printf("\033[2J\033[H");
-    fflush(stdout);
+    static int ansi = -1;
+    if (ansi == -1) {
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD modo = 0;
+        ansi = GetConsoleMode(console, &modo) && SetConsoleMode(console, modo | 0x0004);
+    }
+    if (!ansi) {
+        system("cls");
+        return;
+    }
 #endif
+    printf("\033[H\033[J");
+    fflush(stdout);
 }
 
 void inicializarTorre(Torre *torre) {
@@ -4,7 +4,7 @@
 // Inclui o cabeçalho de histórico para usar o tipo 'Historico'
 #include "historico.h"
 
-#define MAX_DISCOS 5
+#define MAX_DISCOS 10 // Uma linha por disco e larguras 2n - 1: acima disso a tela não cabe
 #define MIN_DISCOS 3
 #define NUM_TORRES 3
 
@@ -0,0 +1,269 @@
+// Executável de microbenchmarks dos caminhos principais do jogo.
+// Os resultados saem em CSV na saída padrão (uma linha por medição), para que possam
+// ser guardados e comparados entre versões:
+//     caso,variante,discos,operacoes,segundos,ns_por_operacao
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pilha.h"
+#include "jogo.h"
+#include "historico.h"
+#include "solucionador.h"
+#include "cronometro.h"
+#include "tela.h"
+#include "benchmark_v2.h"
+
+#ifdef _WIN32
+#define DISPOSITIVO_NULO "NUL"
+#else
+#define DISPOSITIVO_NULO "/dev/null"
+#endif
+
+// Arquivo temporário usado pelas medições do histórico
+#define ARQUIVO_BENCHMARK_HISTORICO "benchmark_historico.dat"
+
+// Maior histórico medido por padrão (10^6; use --max-registros 10000000 para 10^7)
+#define MAX_REGISTROS_PADRAO 1000000
+
+// Quantidade aproximada de operações por medição
+#define OPERACOES_POR_MEDICAO 20000000L
+
+// Partidas acrescentadas um a uma em cada tamanho de histórico
+#define ANEXOS_POR_MEDICAO 100
+
+// Maior número de discos nas medições de exibição (um quadro por movimento da ida e volta)
+#define MAX_DISCOS_EXIBICAO 10
+
+// Soma acumulada para que o compilador não descarte o trabalho medido
+static volatile long sumidouro;
+
+// Imprime uma linha de resultado
+static void registrarResultado(const char* caso, const char* variante, int discos, double operacoes, double segundos) {
+    printf("%s,%s,%d,%.0f,%.6f,%.2f\n", caso, variante, discos, operacoes, segundos,
+           operacoes > 0 ? segundos * 1e9 / operacoes : 0.0);
+    fflush(stdout);
+}
+
+static const char* nomeDoMotor(MotorPilha motor) {
+    return (motor == MOTOR_BITBOARD) ? "bitboard" : "lista";
+}
+
+// Cria 3 pinos com o motor escolhido e a torre completa no pino A
+static int criarPinos(Pilha* pinos[3], MotorPilha motor, int numDiscos) {
+    for (int i = 0; i < 3; i++) {
+        pinos[i] = criarPilhaComMotor((char)('A' + i), motor);
+        if (pinos[i] == NULL) return 0;
+    }
+    for (int d = numDiscos; d >= 1; d--) {
+        empilhar(pinos[0], d);
+    }
+    return 1;
+}
+
+static void liberarPinos(Pilha* pinos[3]) {
+    for (int i = 0; i < 3; i++) {
+        liberarPilha(pinos[i]);
+    }
+}
+
+// Sequência ótima de ida (A -> C) e volta (C -> A), que pode ser repetida
+static Movimento* montarIdaEVolta(int numDiscos, size_t* total) {
+    size_t metade = (size_t) totalMovimentosOtimos(numDiscos);
+    Movimento* movimentos = (Movimento*) malloc(2 * metade * sizeof(Movimento));
+    if (movimentos == NULL) {
+        perror("Erro ao alocar memoria para os movimentos do benchmark");
+        return NULL;
+    }
+    gerarMovimentosOtimos(numDiscos, 0, 2, 0, movimentos, metade);
+    gerarMovimentosOtimos(numDiscos, 2, 0, 0, movimentos + metade, metade);
+    *total = 2 * metade;
+    return movimentos;
+}
+
+// empilhar/desempilhar: monta e desmonta uma torre de n discos
+static void medirEmpilharDesempilhar(MotorPilha motor, int numDiscos) {
+    Pilha* pilha = criarPilhaComMotor('A', motor);
+    if (pilha == NULL) return;
+    long repeticoes = OPERACOES_POR_MEDICAO / (2 * numDiscos);
+    long soma = 0;
+    double inicio = cronometroSegundos();
+    for (long r = 0; r < repeticoes; r++) {
+        for (int d = numDiscos; d >= 1; d--) {
+            empilhar(pilha, d);
+        }
+        for (int d = 1; d <= numDiscos; d++) {
+            soma += desempilhar(pilha);
+        }
+    }
+    double segundos = cronometroSegundos() - inicio;
+    sumidouro += soma;
+    registrarResultado("empilhar_desempilhar", nomeDoMotor(motor), numDiscos, 2.0 * numDiscos * repeticoes, segundos);
+    liberarPilha(pilha);
+}
+
+// Movimentos do jogo (desempilhar + empilhar) seguindo a solução ótima
+static void medirMovimentos(MotorPilha motor, int numDiscos, const Movimento* movimentos, size_t total) {
+    Pilha* pinos[3];
+    if (!criarPinos(pinos, motor, numDiscos)) return;
+    long repeticoes = OPERACOES_POR_MEDICAO / (long) total;
+    if (repeticoes < 1) repeticoes = 1;
+    double inicio = cronometroSegundos();
+    for (long r = 0; r < repeticoes; r++) {
+        for (size_t i = 0; i < total; i++) {
+            empilhar(pinos[movimentos[i].destino], desempilhar(pinos[movimentos[i].origem]));
+        }
+    }
+    double segundos = cronometroSegundos() - inicio;
+    sumidouro += topoDisco(pinos[0]);
+    registrarResultado("mover", nomeDoMotor(motor), numDiscos, (double) total * repeticoes, segundos);
+    liberarPinos(pinos);
+}
+
+// verificarOrdemDiscos sobre uma torre completa
+static void medirVerificacao(MotorPilha motor, int numDiscos) {
+    Pilha* pinos[3];
+    if (!criarPinos(pinos, motor, numDiscos)) return;
+    long repeticoes = OPERACOES_POR_MEDICAO / numDiscos;
+    long soma = 0;
+    double inicio = cronometroSegundos();
+    for (long r = 0; r < repeticoes; r++) {
+        soma += verificarOrdemDiscos(pinos[0], numDiscos);
+    }
+    double segundos = cronometroSegundos() - inicio;
+    sumidouro += soma;
+    registrarResultado("verificar_ordem", nomeDoMotor(motor), numDiscos, (double) repeticoes, segundos);
+    liberarPinos(pinos);
+}
+
+// exibirTorres com a saída desviada para um dispositivo nulo, um movimento entre quadros
+static void medirExibicao(int numDiscos, const Movimento* movimentos, size_t total, FILE* saidaNula, int usarAnsi) {
+    Pilha* pinos[3];
+    if (!criarPinos(pinos, motorPilhaPadrao, numDiscos)) return;
+    telaDefinirSaida(saidaNula, usarAnsi);
+    double inicio = cronometroSegundos();
+    for (size_t i = 0; i < total; i++) {
+        exibirTorres(pinos, 3, numDiscos, (int) i);
+        empilhar(pinos[movimentos[i].destino], desempilhar(pinos[movimentos[i].origem]));
+    }
+    double segundos = cronometroSegundos() - inicio;
+    telaDefinirSaida(NULL, 0);
+    registrarResultado("exibir_torres", usarAnsi ? "incremental" : "completo", numDiscos, (double) total, segundos);
+    liberarPinos(pinos);
+}
+
+// Prepara o histórico global em memória com 'quantidade' partidas sintéticas
+static int montarHistoricoSintetico(size_t quantidade) {
+    historicoGlobal = (HistoricoGlobal*) calloc(1, sizeof(HistoricoGlobal));
+    Partida* registros = (Partida*) calloc(quantidade, sizeof(Partida));
+    if (historicoGlobal == NULL || registros == NULL) {
+        perror("Erro ao alocar memoria para o historico do benchmark");
+        free(registros);
+        return 0;
+    }
+    for (size_t i = 0; i < quantidade; i++) {
+        snprintf(registros[i].nomeJogador, sizeof(registros[i].nomeJogador), "jogador%zu", i % 1000);
+        registros[i].numDiscos = 3 + (int)(i % 8);
+        registros[i].numPinos = 3;
+        registros[i].numMovimentos = (int) totalMovimentosOtimos(registros[i].numDiscos) + (int)(i % 17);
+        registros[i].movimentosDesperdicados = (int)(i % 17);
+        registros[i].deslocamentoMovimentos = SEM_MOVIMENTOS;
+    }
+    historicoGlobal->registros = registros;
+    historicoGlobal->numRegistros = quantidade;
+    historicoGlobal->mapeamento = registros; // Liberado com free por liberarHistoricoGlobal
+    return 1;
+}
+
+// Compactação (gravação completa), carregamento com índices e acréscimo de partidas
+static void medirHistorico(size_t quantidade) {
+    if (!montarHistoricoSintetico(quantidade)) return;
+    double inicio = cronometroSegundos();
+    salvarHistoricoEmArquivo(ARQUIVO_BENCHMARK_HISTORICO);
+    registrarResultado("historico_salvar", "compactar", 0, (double) quantidade, cronometroSegundos() - inicio);
+    liberarHistoricoGlobal();
+
+    historicoGlobal = (HistoricoGlobal*) calloc(1, sizeof(HistoricoGlobal));
+    if (historicoGlobal == NULL) return;
+    inicio = cronometroSegundos();
+    carregarHistoricoDeArquivo(ARQUIVO_BENCHMARK_HISTORICO);
+    double segundos = cronometroSegundos() - inicio;
+    if (historicoGlobal->numRegistros != quantidade) {
+        fprintf(stderr, "Aviso: %zu partidas carregadas, %zu esperadas.\n", historicoGlobal->numRegistros, quantidade);
+    }
+    registrarResultado("historico_carregar", "mmap_e_indices", 0, (double) quantidade, segundos);
+
+    Partida partida = historicoGlobal->registros[0];
+    inicio = cronometroSegundos();
+    for (int i = 0; i < ANEXOS_POR_MEDICAO; i++) {
+        anexarPartidaAoArquivo(ARQUIVO_BENCHMARK_HISTORICO, &partida);
+    }
+    registrarResultado("historico_anexar", "por_partida", 0, (double) ANEXOS_POR_MEDICAO, cronometroSegundos() - inicio);
+    liberarHistoricoGlobal();
+    remove(ARQUIVO_BENCHMARK_HISTORICO);
+}
+
+// Mesmas medições sobre a Torre da versão 2, para comparação
+static void medirVersao2(int numDiscos, const Movimento* movimentos, size_t total, FILE* saidaNula) {
+    long repeticoes = OPERACOES_POR_MEDICAO / (long) total;
+    double segundos = medirTorreV2Movimentos(numDiscos, movimentos, total, repeticoes);
+    registrarResultado("mover", "v2_vetor", numDiscos, (double) total * repeticoes, segundos);
+
+    repeticoes = OPERACOES_POR_MEDICAO / numDiscos;
+    segundos = medirTorreV2Verificacao(numDiscos, repeticoes);
+    registrarResultado("verificar_ordem", "v2_vetor", numDiscos, (double) repeticoes, segundos);
+
+    segundos = medirTorreV2Exibicao(numDiscos, movimentos, total, saidaNula);
+    registrarResultado("exibir_torres", "v2_printf", numDiscos, (double) total, segundos);
+}
+
+/**
+ * @brief Executa todas as medições e imprime os resultados em CSV.
+ * * Opções: --max-registros N limita o maior histórico medido (10^3, 10^4, ... até N).
+ */
+int main(int argc, char* argv[]) {
+    long maxRegistros = MAX_REGISTROS_PADRAO;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--max-registros") == 0 && i + 1 < argc) {
+            maxRegistros = atol(argv[++i]);
+        } else {
+            fprintf(stderr, "Uso: %s [--max-registros N]\n", argv[0]);
+            return 1;
+        }
+    }
+    FILE* saidaNula = fopen(DISPOSITIVO_NULO, "w");
+    if (saidaNula == NULL) {
+        perror("Erro ao abrir o dispositivo nulo");
+        return 1;
+    }
+
+    printf("caso,variante,discos,operacoes,segundos,ns_por_operacao\n");
+    const MotorPilha motores[] = {MOTOR_LISTA, MOTOR_BITBOARD};
+    const int tamanhos[] = {5, 10, 20};
+    for (size_t t = 0; t < sizeof(tamanhos) / sizeof(tamanhos[0]); t++) {
+        size_t total;
+        Movimento* movimentos = montarIdaEVolta(tamanhos[t], &total);
+        if (movimentos == NULL) continue;
+        for (int m = 0; m < 2; m++) {
+            medirEmpilharDesempilhar(motores[m], tamanhos[t]);
+            medirMovimentos(motores[m], tamanhos[t], movimentos, total);
+            medirVerificacao(motores[m], tamanhos[t]);
+        }
+        if (tamanhos[t] <= MAX_DISCOS_EXIBICAO) {
+            medirExibicao(tamanhos[t], movimentos, total, saidaNula, 1);
+            medirExibicao(tamanhos[t], movimentos, total, saidaNula, 0);
+        }
+        if (tamanhos[t] <= MAX_DISCOS_EXIBICAO && tamanhos[t] <= torreV2MaxDiscos()) {
+            medirVersao2(tamanhos[t], movimentos, total, saidaNula);
+        }
+        free(movimentos);
+    }
+    for (long quantidade = 1000; quantidade <= maxRegistros; quantidade *= 10) {
+        medirHistorico((size_t) quantidade);
+    }
+
+    fclose(saidaNula);
+    liberarTela();
+    liberarPoolsPilha();
+    return 0;
+}
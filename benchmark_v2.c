@@ -0,0 +1,109 @@
+// Compila a versão 2 do jogo (HENRIQUE/Código V2, Torre com vetor fixo) dentro do benchmark.
+// Os nomes da V2 coincidem com os da versão atual, então são renomeados antes da inclusão,
+// e o printf da V2 é desviado para o arquivo escolhido pelo benchmark (um dispositivo nulo).
+#include "benchmark_v2.h"
+#include "cronometro.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <string.h>
+
+static FILE* saidaV2 = NULL;
+#define printf(...) fprintf(saidaV2 != NULL ? saidaV2 : stdout, __VA_ARGS__)
+
+#define clear v2Clear
+#define inicializarTorre v2InicializarTorre
+#define empilhar v2Empilhar
+#define desempilhar v2Desempilhar
+#define topo v2Topo
+#define imprimirDisco v2ImprimirDisco
+#define exibirTorres v2ExibirTorres
+#define indiceTorre v2IndiceTorre
+#define jogoConcluido v2JogoConcluido
+#define jogar v2Jogar
+#define instrucoes v2Instrucoes
+#define adicionarHistoricoLista v2AdicionarHistoricoLista
+#define salvarHistoricoArquivo v2SalvarHistoricoArquivo
+#define carregarHistorico v2CarregarHistorico
+#define exibirHistorico v2ExibirHistorico
+#define liberarHistorico v2LiberarHistorico
+
+#include "HENRIQUE/Código V2/torre.c"
+#include "HENRIQUE/Código V2/historico.c"
+
+// Soma acumulada para que o compilador não descarte o trabalho medido
+static volatile long sumidouroV2;
+
+// Monta as torres da V2 com todos os discos no pino A
+static void montarTorresV2(Torre torres[NUM_TORRES], int numDiscos) {
+    for (int i = 0; i < NUM_TORRES; i++) {
+        inicializarTorre(&torres[i]);
+    }
+    for (int i = numDiscos; i >= 1; i--) {
+        empilhar(&torres[0], i);
+    }
+}
+
+/**
+ * @brief Retorna o maior número de discos suportado pela V2 (MAX_DISCOS de torre.h).
+ */
+int torreV2MaxDiscos() {
+    return MAX_DISCOS;
+}
+
+/**
+ * @brief Aplica 'repeticoes' vezes uma sequência de movimentos às torres da V2 (desempilhar + empilhar).
+ * * A sequência deve voltar à posição inicial (ida e volta) para poder ser repetida.
+ * @return O tempo gasto, em segundos.
+ */
+double medirTorreV2Movimentos(int numDiscos, const Movimento* movimentos, size_t total, long repeticoes) {
+    Torre torres[NUM_TORRES];
+    montarTorresV2(torres, numDiscos);
+    double inicio = cronometroSegundos();
+    for (long r = 0; r < repeticoes; r++) {
+        for (size_t i = 0; i < total; i++) {
+            empilhar(&torres[movimentos[i].destino], desempilhar(&torres[movimentos[i].origem]));
+        }
+    }
+    double segundos = cronometroSegundos() - inicio;
+    sumidouroV2 += topo(&torres[0]);
+    return segundos;
+}
+
+/**
+ * @brief Mede jogoConcluido da V2 sobre uma torre completa.
+ * @return O tempo gasto, em segundos.
+ */
+double medirTorreV2Verificacao(int numDiscos, long repeticoes) {
+    Torre torres[NUM_TORRES];
+    montarTorresV2(torres, numDiscos);
+    long soma = 0;
+    double inicio = cronometroSegundos();
+    for (long r = 0; r < repeticoes; r++) {
+        soma += jogoConcluido(&torres[0], numDiscos);
+    }
+    double segundos = cronometroSegundos() - inicio;
+    sumidouroV2 += soma;
+    return segundos;
+}
+
+/**
+ * @brief Mede exibirTorres da V2 (limpeza da tela e printf por caractere) escrevendo em 'saidaNula'.
+ * * Um movimento da sequência é aplicado entre dois quadros, como no jogo.
+ * @return O tempo gasto, em segundos.
+ */
+double medirTorreV2Exibicao(int numDiscos, const Movimento* movimentos, size_t total, FILE* saidaNula) {
+    Torre torres[NUM_TORRES];
+    montarTorresV2(torres, numDiscos);
+    FILE* anterior = saidaV2;
+    saidaV2 = saidaNula;
+    double inicio = cronometroSegundos();
+    for (size_t i = 0; i < total; i++) {
+        exibirTorres(torres, numDiscos);
+        empilhar(&torres[movimentos[i].destino], desempilhar(&torres[movimentos[i].origem]));
+    }
+    fflush(saidaNula);
+    double segundos = cronometroSegundos() - inicio;
+    saidaV2 = anterior;
+    return segundos;
+}
@@ -0,0 +1,14 @@
+#ifndef BENCHMARK_V2_H
+#define BENCHMARK_V2_H
+
+#include <stdio.h>  // Para FILE
+#include <stddef.h> // Para size_t
+#include "solucionador.h" // Para Movimento
+
+// Protótipos das medições da versão 2 (Torre com vetor fixo), compilada em benchmark_v2.c
+int torreV2MaxDiscos();
+double medirTorreV2Movimentos(int numDiscos, const Movimento* movimentos, size_t total, long repeticoes);
+double medirTorreV2Verificacao(int numDiscos, long repeticoes);
+double medirTorreV2Exibicao(int numDiscos, const Movimento* movimentos, size_t total, FILE* saidaNula);
+
+#endif // BENCHMARK_V2_H
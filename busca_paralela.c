@@ -0,0 +1,341 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // Para sysconf
+#endif
+
+#include "busca_paralela.h"
+#include "frame_stewart.h" // Para comparar com a sequência de Frame–Stewart
+#include "cronometro.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef _WIN32
+#include <windows.h> // Para GetSystemInfo
+#else
+#include <unistd.h>  // Para sysconf
+#endif
+
+// Quantidade de estados que uma thread retira da fronteira de cada vez
+#define BLOCO_DE_TRABALHO 256
+
+// Capacidade inicial dos vetores de saída de cada thread
+#define SAIDA_INICIAL 1024
+
+// Operações atômicas (builtins do GCC/Clang, disponíveis também no MinGW)
+#define ATOMICO_LER(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define ATOMICO_SOMAR(ptr, valor) __atomic_fetch_add((ptr), (valor), __ATOMIC_RELAXED)
+#define ATOMICO_OU(ptr, valor) __atomic_fetch_or((ptr), (valor), __ATOMIC_RELAXED)
+#define ATOMICO_GRAVAR(ptr, valor) __atomic_store_n((ptr), (valor), __ATOMIC_RELAXED)
+
+// Trecho da fronteira que pertence a uma thread. O cursor avança por soma atômica,
+// tanto pela dona quanto por quem rouba, então um bloco nunca é processado duas vezes.
+typedef struct {
+    size_t proximo; // Próxima posição não reservada (pode passar de 'fim')
+    size_t fim;     // Fim do trecho
+    char preenchimento[64 - 2 * sizeof(size_t)]; // Evita falso compartilhamento entre threads
+} TrechoFronteira;
+
+// Dados compartilhados por todas as threads em um nível da busca
+typedef struct {
+    int numDiscos;
+    int numPinos;
+    uint64_t potencias[BUSCA_MAX_DISCOS + 1]; // k^d
+    uint64_t* visitados;                     // Um bit por estado, atualizado com OU atômico
+    const uint64_t* fronteira;               // Estados do nível atual
+    TrechoFronteira trechos[BUSCA_MAX_THREADS];
+    int numThreads;
+    uint64_t destino;
+    int encontrado;                          // Vira 1 (atomicamente) quando alguém gera o destino
+} BuscaCompartilhada;
+
+// Dados de uma thread
+typedef struct {
+    BuscaCompartilhada* busca;
+    int id;
+    uint64_t* saida;     // Estados novos gerados pela thread neste nível
+    size_t quantidade;
+    size_t capacidade;
+    uint64_t expandidos;
+    uint64_t roubos;
+    int erro;
+} TrabalhadorBusca;
+
+/**
+ * @brief Retorna o número de núcleos disponíveis (pelo menos 1).
+ */
+int numeroDeNucleos() {
+#ifdef _WIN32
+    SYSTEM_INFO informacoes;
+    GetSystemInfo(&informacoes);
+    int nucleos = (int) informacoes.dwNumberOfProcessors;
+#else
+    int nucleos = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return (nucleos > 0) ? nucleos : 1;
+}
+
+// Índice base k do estado (posição no vetor de visitados)
+static inline uint64_t indiceDoEstado(const BuscaCompartilhada* busca, uint64_t estado) {
+    uint64_t indice = 0;
+    for (int d = 1; d <= busca->numDiscos; d++) {
+        indice += ((estado >> (BUSCA_BITS_POR_DISCO * (d - 1))) & 7) * busca->potencias[d - 1];
+    }
+    return indice;
+}
+
+// Reserva um bloco da fronteira: primeiro do próprio trecho, depois roubando dos outros
+static int reservarBloco(TrabalhadorBusca* trabalhador, size_t* inicio, size_t* fim) {
+    BuscaCompartilhada* busca = trabalhador->busca;
+    for (int i = 0; i < busca->numThreads; i++) {
+        TrechoFronteira* trecho = &busca->trechos[(trabalhador->id + i) % busca->numThreads];
+        if (ATOMICO_LER(&trecho->proximo) >= trecho->fim) {
+            continue;
+        }
+        size_t posicao = ATOMICO_SOMAR(&trecho->proximo, (size_t) BLOCO_DE_TRABALHO);
+        if (posicao < trecho->fim) {
+            *inicio = posicao;
+            *fim = (posicao + BLOCO_DE_TRABALHO < trecho->fim) ? posicao + BLOCO_DE_TRABALHO : trecho->fim;
+            if (i > 0) trabalhador->roubos++;
+            return 1;
+        }
+    }
+    return 0; // Não sobrou trabalho neste nível
+}
+
+static int guardarNaSaida(TrabalhadorBusca* trabalhador, uint64_t estado) {
+    if (trabalhador->quantidade == trabalhador->capacidade) {
+        size_t novaCapacidade = (trabalhador->capacidade == 0) ? SAIDA_INICIAL : trabalhador->capacidade * 2;
+        uint64_t* novaSaida = (uint64_t*) realloc(trabalhador->saida, novaCapacidade * sizeof(uint64_t));
+        if (novaSaida == NULL) {
+            return 0;
+        }
+        trabalhador->saida = novaSaida;
+        trabalhador->capacidade = novaCapacidade;
+    }
+    trabalhador->saida[trabalhador->quantidade++] = estado;
+    return 1;
+}
+
+// Expande os estados de um nível até acabar o trabalho (próprio e roubado)
+static void* expandirNivel(void* argumento) {
+    TrabalhadorBusca* trabalhador = (TrabalhadorBusca*) argumento;
+    BuscaCompartilhada* busca = trabalhador->busca;
+    int numDiscos = busca->numDiscos;
+    int numPinos = busca->numPinos;
+    size_t inicio, fim;
+
+    while (!trabalhador->erro && !ATOMICO_LER(&busca->encontrado) && reservarBloco(trabalhador, &inicio, &fim)) {
+        for (size_t i = inicio; i < fim; i++) {
+            uint64_t estado = busca->fronteira[i];
+            uint64_t indice = indiceDoEstado(busca, estado);
+            trabalhador->expandidos++;
+
+            // Menor disco de cada pino (0 = pino vazio)
+            int topos[ESTADO_MAX_PINOS] = {0};
+            int encontrados = 0;
+            for (int d = 1; d <= numDiscos && encontrados < numPinos; d++) {
+                int pino = (int)((estado >> (BUSCA_BITS_POR_DISCO * (d - 1))) & 7);
+                if (topos[pino] == 0) {
+                    topos[pino] = d;
+                    encontrados++;
+                }
+            }
+
+            for (int o = 0; o < numPinos; o++) {
+                int disco = topos[o];
+                if (disco == 0) continue;
+                int deslocamento = BUSCA_BITS_POR_DISCO * (disco - 1);
+                for (int d = 0; d < numPinos; d++) {
+                    if (d == o || (topos[d] != 0 && topos[d] < disco)) continue;
+                    uint64_t vizinho = (estado & ~((uint64_t)7 << deslocamento)) | ((uint64_t) d << deslocamento);
+                    uint64_t indiceVizinho = indice + ((uint64_t) d - (uint64_t) o) * busca->potencias[disco - 1];
+                    uint64_t bit = (uint64_t)1 << (indiceVizinho % 64);
+                    uint64_t* palavra = &busca->visitados[indiceVizinho / 64];
+                    // Leitura simples antes do OU atômico: a maioria dos vizinhos já foi vista
+                    if ((ATOMICO_LER(palavra) & bit) || (ATOMICO_OU(palavra, bit) & bit)) continue;
+                    if (vizinho == busca->destino) {
+                        ATOMICO_GRAVAR(&busca->encontrado, 1);
+                        return NULL;
+                    }
+                    if (!guardarNaSaida(trabalhador, vizinho)) {
+                        trabalhador->erro = 1;
+                        return NULL;
+                    }
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Busca em largura paralela, por níveis, sobre o grafo de estados de k pinos.
+ * * A fronteira de cada nível é dividida em um trecho por thread; cada thread consome blocos
+ * * do próprio trecho e, quando acaba, rouba blocos dos trechos das outras. Os visitados são
+ * * um vetor de bits compartilhado, marcado com OU atômico, e cada thread guarda os estados
+ * * novos em um vetor próprio, juntado na fronteira do próximo nível ao fim do nível.
+ * @param numDiscos O número de discos.
+ * @param numPinos O número de pinos.
+ * @param origem Estado de partida (3 bits por disco, do menor para o maior).
+ * @param destino Estado de chegada.
+ * @param numThreads Threads a usar (0 = uma por núcleo).
+ * @param estatisticas Recebe as medidas da busca (pode ser NULL).
+ * @return A distância mínima entre os estados, ou -1 em caso de erro.
+ */
+long long distanciaParalela(int numDiscos, int numPinos, uint64_t origem, uint64_t destino, int numThreads,
+                            EstatisticasBuscaParalela* estatisticas) {
+    if (numDiscos < 1 || numDiscos > BUSCA_MAX_DISCOS || numPinos < ESTADO_MIN_PINOS || numPinos > ESTADO_MAX_PINOS) {
+        fprintf(stderr, "Erro: use de 1 a %d discos e de %d a %d pinos.\n",
+                BUSCA_MAX_DISCOS, ESTADO_MIN_PINOS, ESTADO_MAX_PINOS);
+        return -1;
+    }
+    static BuscaCompartilhada busca; // Grande demais para a pilha de chamadas
+    memset(&busca, 0, sizeof(busca));
+    busca.numDiscos = numDiscos;
+    busca.numPinos = numPinos;
+    busca.destino = destino;
+    busca.potencias[0] = 1;
+    for (int d = 1; d <= numDiscos; d++) {
+        busca.potencias[d] = busca.potencias[d - 1] * (uint64_t) numPinos;
+        if (busca.potencias[d] > BUSCA_MAX_ESTADOS) {
+            fprintf(stderr, "Erro: %d discos com %d pinos passam do limite de %llu estados.\n",
+                    numDiscos, numPinos, (unsigned long long) BUSCA_MAX_ESTADOS);
+            return -1;
+        }
+    }
+    uint64_t totalEstados = busca.potencias[numDiscos];
+    if (numThreads <= 0) numThreads = numeroDeNucleos();
+    if (numThreads > BUSCA_MAX_THREADS) numThreads = BUSCA_MAX_THREADS;
+    busca.numThreads = numThreads;
+
+    size_t bytesVisitados = (size_t)((totalEstados + 63) / 64) * sizeof(uint64_t);
+    busca.visitados = (uint64_t*) calloc(1, bytesVisitados);
+    uint64_t* fronteira = (uint64_t*) malloc(sizeof(uint64_t));
+    TrabalhadorBusca trabalhadores[BUSCA_MAX_THREADS];
+    pthread_t threads[BUSCA_MAX_THREADS];
+    memset(trabalhadores, 0, sizeof(trabalhadores));
+    if (busca.visitados == NULL || fronteira == NULL) {
+        perror("Erro ao alocar memoria para a busca paralela");
+        free(busca.visitados);
+        free(fronteira);
+        return -1;
+    }
+    for (int t = 0; t < numThreads; t++) {
+        trabalhadores[t].busca = &busca;
+        trabalhadores[t].id = t;
+    }
+
+    uint64_t indiceOrigem = indiceDoEstado(&busca, origem);
+    busca.visitados[indiceOrigem / 64] |= (uint64_t)1 << (indiceOrigem % 64);
+    fronteira[0] = origem;
+    size_t tamanhoFronteira = 1;
+    size_t memoriaPico = bytesVisitados;
+    long long distancia = (origem == destino) ? 0 : -1;
+    int erro = 0;
+    double inicio = cronometroSegundos();
+
+    for (long long nivel = 0; distancia < 0 && !erro && tamanhoFronteira > 0; nivel++) {
+        // Divide a fronteira em trechos iguais, um por thread
+        busca.fronteira = fronteira;
+        for (int t = 0; t < numThreads; t++) {
+            busca.trechos[t].proximo = tamanhoFronteira * (size_t) t / (size_t) numThreads;
+            busca.trechos[t].fim = tamanhoFronteira * (size_t)(t + 1) / (size_t) numThreads;
+            trabalhadores[t].quantidade = 0;
+        }
+        // A thread principal trabalha como a thread 0
+        int criadas = 1;
+        for (int t = 1; t < numThreads; t++, criadas++) {
+            if (pthread_create(&threads[t], NULL, expandirNivel, &trabalhadores[t]) != 0) {
+                break; // As threads que faltaram têm o trabalho roubado pelas outras
+            }
+        }
+        expandirNivel(&trabalhadores[0]);
+        for (int t = 1; t < criadas; t++) {
+            pthread_join(threads[t], NULL);
+        }
+
+        // Junta as saídas das threads na fronteira do próximo nível
+        size_t tamanhoProxima = 0;
+        size_t memoria = bytesVisitados + tamanhoFronteira * sizeof(uint64_t);
+        for (int t = 0; t < numThreads; t++) {
+            tamanhoProxima += trabalhadores[t].quantidade;
+            memoria += trabalhadores[t].capacidade * sizeof(uint64_t);
+            erro |= trabalhadores[t].erro;
+        }
+        if (memoria > memoriaPico) memoriaPico = memoria;
+        if (busca.encontrado) {
+            distancia = nivel + 1;
+            break;
+        }
+        free(fronteira);
+        fronteira = (uint64_t*) malloc((tamanhoProxima > 0 ? tamanhoProxima : 1) * sizeof(uint64_t));
+        if (fronteira == NULL) {
+            erro = 1;
+            break;
+        }
+        size_t posicao = 0;
+        for (int t = 0; t < numThreads; t++) {
+            memcpy(fronteira + posicao, trabalhadores[t].saida, trabalhadores[t].quantidade * sizeof(uint64_t));
+            posicao += trabalhadores[t].quantidade;
+        }
+        tamanhoFronteira = tamanhoProxima;
+    }
+    double segundos = cronometroSegundos() - inicio;
+    if (erro) {
+        perror("Erro ao alocar memoria para a fronteira da busca paralela");
+    }
+
+    if (estatisticas != NULL) {
+        memset(estatisticas, 0, sizeof(EstatisticasBuscaParalela));
+        for (int t = 0; t < numThreads; t++) {
+            estatisticas->estadosVisitados += trabalhadores[t].expandidos;
+            estatisticas->roubos += trabalhadores[t].roubos;
+        }
+        estatisticas->totalEstados = totalEstados;
+        estatisticas->threads = numThreads;
+        estatisticas->segundos = segundos;
+        estatisticas->memoriaPico = memoriaPico;
+    }
+    for (int t = 0; t < numThreads; t++) {
+        free(trabalhadores[t].saida);
+    }
+    free(fronteira);
+    free(busca.visitados);
+    return erro ? -1 : distancia;
+}
+
+/**
+ * @brief Calcula a distância ótima da torre no pino A até o último pino, com k pinos, em paralelo.
+ * * Compara o resultado com o número de movimentos da sequência de Frame–Stewart.
+ * @param numDiscos O número de discos.
+ * @param numPinos O número de pinos.
+ * @param numThreads Threads a usar (0 = uma por núcleo).
+ * @return 0 em caso de sucesso, 1 em caso de erro.
+ */
+int executarBuscaParalela(int numDiscos, int numPinos, int numThreads) {
+    if (numDiscos < 1 || numDiscos > BUSCA_MAX_DISCOS || numPinos < ESTADO_MIN_PINOS || numPinos > ESTADO_MAX_PINOS) {
+        fprintf(stderr, "Erro: use de 1 a %d discos e de %d a %d pinos.\n",
+                BUSCA_MAX_DISCOS, ESTADO_MIN_PINOS, ESTADO_MAX_PINOS);
+        return 1;
+    }
+    uint64_t destino = 0;
+    for (int d = 1; d <= numDiscos; d++) {
+        destino |= (uint64_t)(numPinos - 1) << (BUSCA_BITS_POR_DISCO * (d - 1));
+    }
+    EstatisticasBuscaParalela estatisticas;
+    long long distancia = distanciaParalela(numDiscos, numPinos, 0, destino, numThreads, &estatisticas);
+    if (distancia < 0) {
+        return 1;
+    }
+    printf("%d discos, %d pinos: distancia otima %lld movimentos (Frame-Stewart: %llu)\n", numDiscos, numPinos,
+           distancia, (unsigned long long) movimentosOtimosMultiPinos(numDiscos, numPinos));
+    fprintf(stderr, "Estados expandidos: %llu de %llu\n", (unsigned long long) estatisticas.estadosVisitados,
+            (unsigned long long) estatisticas.totalEstados);
+    fprintf(stderr, "Threads: %d, blocos roubados: %llu\n", estatisticas.threads,
+            (unsigned long long) estatisticas.roubos);
+    fprintf(stderr, "Tempo: %.3f s (%.0f estados/s)\n", estatisticas.segundos,
+            estatisticas.segundos > 0 ? (double) estatisticas.estadosVisitados / estatisticas.segundos : 0.0);
+    fprintf(stderr, "Memoria de pico: %.1f MB\n", (double) estatisticas.memoriaPico / (1024.0 * 1024.0));
+    return 0;
+}
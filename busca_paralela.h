@@ -0,0 +1,34 @@
+#ifndef BUSCA_PARALELA_H
+#define BUSCA_PARALELA_H
+
+#include <stddef.h> // Para size_t
+#include <stdint.h> // Para uint64_t
+#include "estado.h"
+
+// Estado compactado de k pinos: 3 bits por disco (pinos 0 a 7), até 21 discos por palavra
+#define BUSCA_BITS_POR_DISCO 3
+#define BUSCA_MAX_DISCOS 21
+
+// Maior grafo aceito: k^n estados, 1 bit por estado no vetor de visitados (2^33 bits = 1 GB)
+#define BUSCA_MAX_ESTADOS ((uint64_t)1 << 33)
+
+// Maior número de threads da busca
+#define BUSCA_MAX_THREADS 64
+
+// Medidas de uma busca paralela
+typedef struct {
+    uint64_t estadosVisitados; // Estados expandidos
+    uint64_t totalEstados;     // k^n
+    int threads;               // Threads usadas
+    uint64_t roubos;           // Blocos de trabalho tomados de outras threads
+    double segundos;           // Tempo da busca
+    size_t memoriaPico;        // Maior soma de bytes alocados ao mesmo tempo
+} EstatisticasBuscaParalela;
+
+// Protótipos da busca em largura paralela para k pinos
+int numeroDeNucleos();
+long long distanciaParalela(int numDiscos, int numPinos, uint64_t origem, uint64_t destino, int numThreads,
+                            EstatisticasBuscaParalela* estatisticas);
+int executarBuscaParalela(int numDiscos, int numPinos, int numThreads);
+
+#endif // BUSCA_PARALELA_H
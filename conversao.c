@@ -0,0 +1,778 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // Para stat
+#endif
+
+#include "conversao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h> // Para INT_MAX
+
+#ifndef _WIN32
+#include <sys/stat.h> // Para stat (origem e destino são o mesmo arquivo?)
+#endif
+
+#include "estado.h"        // Limites de discos e pinos
+#include "frame_stewart.h" // Mínimo de movimentos, quando a origem não informa o desperdício
+#include "cronometro.h"    // Para medir a vazão da conversão
+
+// Campos de uma partida nos formatos de texto (colunas do CSV e chaves do JSON)
+typedef enum {
+    CAMPO_NOME,
+    CAMPO_DISCOS,
+    CAMPO_PINOS,
+    CAMPO_MOVIMENTOS,
+    CAMPO_DESPERDICADOS,
+    CAMPO_DATA,
+    NUM_CAMPOS,
+    CAMPO_IGNORADO = NUM_CAMPOS
+} CampoHistorico;
+
+// Nomes dos campos, na ordem de CampoHistorico (também a ordem das colunas exportadas)
+static const char* const nomesDosCampos[NUM_CAMPOS] = {
+    "nome", "discos", "pinos", "movimentos", "desperdicados", "data"
+};
+
+// Maior número de colunas de um CSV importado (as demais são ignoradas)
+#define MAX_COLUNAS_CSV 32
+
+// Maior campo de texto lido (nomes e datas mais longos são truncados)
+#define TAMANHO_MAXIMO_CAMPO 256
+
+// Resultado da leitura de um registro
+#define REGISTRO_LIDO 1
+#define REGISTRO_FIM 0
+#define REGISTRO_INVALIDO -1  // Registro pulado (campos faltando ou fora dos limites)
+#define REGISTRO_ERRO -2      // Arquivo malformado: a conversão para
+
+// Leitura em blocos de CONVERSAO_TAMANHO_BUFFER bytes, consumida um caractere por vez
+typedef struct {
+    FILE* arquivo;
+    unsigned char* dados;
+    size_t tamanho;
+    size_t posicao;
+} LeitorBuffer;
+
+// Escrita acumulada em um bloco de CONVERSAO_TAMANHO_BUFFER bytes
+typedef struct {
+    FILE* arquivo;
+    char* dados;
+    size_t usados;
+    int erro;
+} EscritorBuffer;
+
+// Estado de uma conversão em andamento
+typedef struct {
+    FormatoHistorico formatoOrigem;
+    FormatoHistorico formatoDestino;
+    LeitorBuffer leitor;
+    EscritorBuffer escritor;
+    CampoHistorico colunas[MAX_COLUNAS_CSV]; // Campo de cada coluna do CSV de origem
+    int numColunas;
+    uint64_t registrosRestantes;             // Registros ainda não lidos do .dat de origem
+    CabecalhoHistorico cabecalhoDestino;     // Cabeçalho do .dat de destino (contador atualizado no fim)
+    int primeiroJson;                        // 1 até o primeiro objeto do JSON de destino
+} Conversao;
+
+// Recarrega o buffer de leitura; retorna 0 no fim do arquivo
+static int recarregarLeitor(LeitorBuffer* leitor) {
+    leitor->tamanho = fread(leitor->dados, 1, CONVERSAO_TAMANHO_BUFFER, leitor->arquivo);
+    leitor->posicao = 0;
+    return leitor->tamanho > 0;
+}
+
+static inline int lerCaractere(LeitorBuffer* leitor) {
+    if (leitor->posicao == leitor->tamanho && !recarregarLeitor(leitor)) {
+        return EOF;
+    }
+    return leitor->dados[leitor->posicao++];
+}
+
+static inline int espiarCaractere(LeitorBuffer* leitor) {
+    if (leitor->posicao == leitor->tamanho && !recarregarLeitor(leitor)) {
+        return EOF;
+    }
+    return leitor->dados[leitor->posicao];
+}
+
+// Copia 'quantidade' bytes da entrada; retorna 0 se o arquivo acabar antes
+static int lerBytes(LeitorBuffer* leitor, void* destino, size_t quantidade) {
+    unsigned char* saida = (unsigned char*) destino;
+    while (quantidade > 0) {
+        if (leitor->posicao == leitor->tamanho && !recarregarLeitor(leitor)) {
+            return 0;
+        }
+        size_t parte = leitor->tamanho - leitor->posicao;
+        if (parte > quantidade) parte = quantidade;
+        memcpy(saida, leitor->dados + leitor->posicao, parte);
+        leitor->posicao += parte;
+        saida += parte;
+        quantidade -= parte;
+    }
+    return 1;
+}
+
+// Envia o que estiver acumulado no buffer de escrita
+static void esvaziarEscritor(EscritorBuffer* escritor) {
+    if (escritor->usados > 0 && fwrite(escritor->dados, 1, escritor->usados, escritor->arquivo) != escritor->usados) {
+        escritor->erro = 1;
+    }
+    escritor->usados = 0;
+}
+
+static void escreverBytes(EscritorBuffer* escritor, const void* dados, size_t quantidade) {
+    if (escritor->usados + quantidade > CONVERSAO_TAMANHO_BUFFER) {
+        esvaziarEscritor(escritor);
+    }
+    memcpy(escritor->dados + escritor->usados, dados, quantidade);
+    escritor->usados += quantidade;
+}
+
+static inline void escreverCaractere(EscritorBuffer* escritor, char c) {
+    if (escritor->usados == CONVERSAO_TAMANHO_BUFFER) {
+        esvaziarEscritor(escritor);
+    }
+    escritor->dados[escritor->usados++] = c;
+}
+
+static void escreverTexto(EscritorBuffer* escritor, const char* texto) {
+    escreverBytes(escritor, texto, strlen(texto));
+}
+
+// Escreve um inteiro em decimal sem passar pelo printf
+static void escreverInteiro(EscritorBuffer* escritor, long long valor) {
+    char digitos[24];
+    int quantidade = 0;
+    unsigned long long resto = (valor < 0) ? 0ULL - (unsigned long long) valor : (unsigned long long) valor;
+    do {
+        digitos[quantidade++] = (char)('0' + resto % 10);
+        resto /= 10;
+    } while (resto > 0);
+    if (valor < 0) {
+        digitos[quantidade++] = '-';
+    }
+    while (quantidade > 0) {
+        escreverCaractere(escritor, digitos[--quantidade]);
+    }
+}
+
+// Converte um texto decimal (com espaços em volta) em int; retorna 0 se não for um número válido
+static int converterInteiro(const char* texto, size_t tamanho, int* valor) {
+    size_t i = 0;
+    while (i < tamanho && (texto[i] == ' ' || texto[i] == '\t')) i++;
+    int negativo = (i < tamanho && texto[i] == '-');
+    if (negativo || (i < tamanho && texto[i] == '+')) i++;
+    long long numero = 0;
+    size_t inicioDigitos = i;
+    while (i < tamanho && texto[i] >= '0' && texto[i] <= '9') {
+        numero = numero * 10 + (texto[i] - '0');
+        if (numero > INT_MAX) return 0;
+        i++;
+    }
+    if (i == inicioDigitos) return 0;
+    while (i < tamanho && (texto[i] == ' ' || texto[i] == '\t')) i++;
+    if (i != tamanho) return 0;
+    *valor = (int)(negativo ? -numero : numero);
+    return 1;
+}
+
+// Identifica um campo pelo nome (coluna do CSV ou chave do JSON)
+static CampoHistorico campoPeloNome(const char* nome, size_t tamanho) {
+    for (int c = 0; c < NUM_CAMPOS; c++) {
+        if (strlen(nomesDosCampos[c]) == tamanho && memcmp(nomesDosCampos[c], nome, tamanho) == 0) {
+            return (CampoHistorico) c;
+        }
+    }
+    return CAMPO_IGNORADO;
+}
+
+// Guarda o valor de um campo no registro; retorna 0 se um campo numérico não for um número
+static int aplicarCampo(RegistroConversao* registro, CampoHistorico campo, const char* texto, size_t tamanho,
+                        unsigned* presentes) {
+    Partida* partida = &registro->partida;
+    int ok = 1;
+    switch (campo) {
+        case CAMPO_NOME: {
+            size_t copiar = (tamanho < sizeof(partida->nomeJogador) - 1) ? tamanho : sizeof(partida->nomeJogador) - 1;
+            memcpy(partida->nomeJogador, texto, copiar);
+            partida->nomeJogador[copiar] = '\0';
+            break;
+        }
+        case CAMPO_DATA: {
+            size_t copiar = (tamanho < sizeof(registro->data) - 1) ? tamanho : sizeof(registro->data) - 1;
+            memcpy(registro->data, texto, copiar);
+            registro->data[copiar] = '\0';
+            break;
+        }
+        case CAMPO_DISCOS: ok = converterInteiro(texto, tamanho, &partida->numDiscos); break;
+        case CAMPO_PINOS: ok = converterInteiro(texto, tamanho, &partida->numPinos); break;
+        case CAMPO_MOVIMENTOS: ok = converterInteiro(texto, tamanho, &partida->numMovimentos); break;
+        case CAMPO_DESPERDICADOS: ok = converterInteiro(texto, tamanho, &partida->movimentosDesperdicados); break;
+        default: return 1;
+    }
+    if (ok) *presentes |= 1u << campo;
+    return ok;
+}
+
+// Completa e confere um registro lido da origem (qualquer formato).
+// Sem pinos, vale 3 (como na V2); sem desperdício, é o total menos o mínimo, como na migração do .dat.
+static int finalizarRegistro(RegistroConversao* registro, unsigned presentes) {
+    Partida* partida = &registro->partida;
+    unsigned obrigatorios = (1u << CAMPO_NOME) | (1u << CAMPO_DISCOS) | (1u << CAMPO_MOVIMENTOS);
+    if ((presentes & obrigatorios) != obrigatorios) {
+        return REGISTRO_INVALIDO;
+    }
+    if (!(presentes & (1u << CAMPO_PINOS))) {
+        partida->numPinos = ESTADO_MIN_PINOS;
+    }
+    if (partida->numDiscos < 1 || partida->numDiscos > ESTADO_MAX_DISCOS || partida->numPinos < ESTADO_MIN_PINOS ||
+        partida->numPinos > ESTADO_MAX_PINOS || partida->numMovimentos < 0) {
+        return REGISTRO_INVALIDO;
+    }
+    // Menos movimentos que o mínimo para os discos e pinos: a partida é impossível
+    uint64_t minimo = movimentosOtimosMultiPinos(partida->numDiscos, partida->numPinos);
+    if ((uint64_t) partida->numMovimentos < minimo) {
+        return REGISTRO_INVALIDO;
+    }
+    if (!(presentes & (1u << CAMPO_DESPERDICADOS))) {
+        partida->movimentosDesperdicados = ((uint64_t) partida->numMovimentos > minimo)
+                                           ? (int)((uint64_t) partida->numMovimentos - minimo) : 0;
+    } else if (partida->movimentosDesperdicados < 0 || partida->movimentosDesperdicados > partida->numMovimentos) {
+        return REGISTRO_INVALIDO;
+    }
+    // Os movimentos ficam no arquivo de movimentos ao lado do .dat de origem, que não é convertido
+    partida->deslocamentoMovimentos = SEM_MOVIMENTOS;
+    return REGISTRO_LIDO;
+}
+
+// Lê um campo de texto até 'separador', fim de linha ou fim do arquivo.
+// Com 'aspas', aceita campos entre aspas duplas com "" para uma aspa (CSV).
+// Retorna o caractere que terminou o campo (separador, '\n' ou EOF).
+static int lerCampoTexto(LeitorBuffer* leitor, int separador, int aspas, char* campo, size_t* tamanho) {
+    size_t usados = 0;
+    int c = lerCaractere(leitor);
+    if (aspas && c == '"') {
+        while ((c = lerCaractere(leitor)) != EOF) {
+            if (c == '"') {
+                if (espiarCaractere(leitor) != '"') break;
+                lerCaractere(leitor); // "" dentro das aspas
+            }
+            if (usados < TAMANHO_MAXIMO_CAMPO - 1) campo[usados++] = (char) c;
+        }
+        c = lerCaractere(leitor);
+    }
+    while (c != separador && c != '\n' && c != EOF) {
+        if (usados < TAMANHO_MAXIMO_CAMPO - 1) campo[usados++] = (char) c;
+        c = lerCaractere(leitor);
+    }
+    if (usados > 0 && campo[usados - 1] == '\r') usados--; // Fim de linha do Windows
+    campo[usados] = '\0';
+    *tamanho = usados;
+    return c;
+}
+
+// Lê a linha de cabeçalho do CSV e associa cada coluna a um campo
+static int lerCabecalhoCsv(Conversao* conversao) {
+    char campo[TAMANHO_MAXIMO_CAMPO];
+    size_t tamanho;
+    int terminador;
+    conversao->numColunas = 0;
+    do {
+        terminador = lerCampoTexto(&conversao->leitor, ',', 1, campo, &tamanho);
+        if (conversao->numColunas < MAX_COLUNAS_CSV) {
+            conversao->colunas[conversao->numColunas++] = campoPeloNome(campo, tamanho);
+        }
+    } while (terminador == ',');
+    for (int c = 0; c < conversao->numColunas; c++) {
+        if (conversao->colunas[c] == CAMPO_NOME) return 1;
+    }
+    fprintf(stderr, "Erro: o cabecalho do CSV precisa ter as colunas nome, discos e movimentos.\n");
+    return 0;
+}
+
+// Lê uma linha do CSV (colunas do cabeçalho) ou da V2 (nome;data;discos;movimentos)
+static int lerRegistroDeLinha(Conversao* conversao, RegistroConversao* registro) {
+    static const CampoHistorico colunasV2[] = {CAMPO_NOME, CAMPO_DATA, CAMPO_DISCOS, CAMPO_MOVIMENTOS};
+    int csv = conversao->formatoOrigem == FORMATO_CSV;
+    const CampoHistorico* colunas = csv ? conversao->colunas : colunasV2;
+    int numColunas = csv ? conversao->numColunas : (int)(sizeof(colunasV2) / sizeof(colunasV2[0]));
+    char campo[TAMANHO_MAXIMO_CAMPO];
+    while (1) {
+        if (espiarCaractere(&conversao->leitor) == EOF) {
+            return REGISTRO_FIM;
+        }
+        unsigned presentes = 0;
+        int valido = 1;
+        int coluna = 0;
+        int terminador;
+        size_t tamanho;
+        size_t tamanhoLinha = 0;
+        do {
+            terminador = lerCampoTexto(&conversao->leitor, csv ? ',' : ';', csv, campo, &tamanho);
+            tamanhoLinha += tamanho;
+            if (coluna < numColunas) {
+                valido &= aplicarCampo(registro, colunas[coluna], campo, tamanho, &presentes);
+            }
+            coluna++;
+        } while (terminador != '\n' && terminador != EOF && (csv || terminador == ';'));
+        if (coluna == 1 && tamanhoLinha == 0) {
+            continue; // Linha em branco
+        }
+        return valido ? finalizarRegistro(registro, presentes) : REGISTRO_INVALIDO;
+    }
+}
+
+// Pula espaços em branco do JSON e devolve o próximo caractere (sem consumi-lo)
+static int pularEspacosJson(LeitorBuffer* leitor) {
+    int c = espiarCaractere(leitor);
+    while (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+        leitor->posicao++;
+        c = espiarCaractere(leitor);
+    }
+    return c;
+}
+
+// Acrescenta um código Unicode ao campo, em UTF-8
+static void anexarUtf8(char* campo, size_t* usados, unsigned codigo) {
+    char bytes[4];
+    int quantidade;
+    if (codigo < 0x80) {
+        bytes[0] = (char) codigo;
+        quantidade = 1;
+    } else if (codigo < 0x800) {
+        bytes[0] = (char)(0xC0 | (codigo >> 6));
+        bytes[1] = (char)(0x80 | (codigo & 0x3F));
+        quantidade = 2;
+    } else if (codigo < 0x10000) {
+        bytes[0] = (char)(0xE0 | (codigo >> 12));
+        bytes[1] = (char)(0x80 | ((codigo >> 6) & 0x3F));
+        bytes[2] = (char)(0x80 | (codigo & 0x3F));
+        quantidade = 3;
+    } else {
+        bytes[0] = (char)(0xF0 | (codigo >> 18));
+        bytes[1] = (char)(0x80 | ((codigo >> 12) & 0x3F));
+        bytes[2] = (char)(0x80 | ((codigo >> 6) & 0x3F));
+        bytes[3] = (char)(0x80 | (codigo & 0x3F));
+        quantidade = 4;
+    }
+    for (int i = 0; i < quantidade && *usados < TAMANHO_MAXIMO_CAMPO - 1; i++) {
+        campo[(*usados)++] = bytes[i];
+    }
+}
+
+// Lê os 4 dígitos hexadecimais de um \uXXXX; retorna -1 se forem inválidos
+static long lerHexadecimalJson(LeitorBuffer* leitor) {
+    long codigo = 0;
+    for (int i = 0; i < 4; i++) {
+        int c = lerCaractere(leitor);
+        int digito = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                   : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+        if (digito < 0) return -1;
+        codigo = codigo * 16 + digito;
+    }
+    return codigo;
+}
+
+// Lê uma string JSON (a aspa de abertura já foi consumida); retorna 0 se ela estiver malformada
+static int lerTextoJson(LeitorBuffer* leitor, char* campo, size_t* tamanho) {
+    size_t usados = 0;
+    int c;
+    while ((c = lerCaractere(leitor)) != '"') {
+        if (c == EOF) return 0;
+        if (c == '\\') {
+            c = lerCaractere(leitor);
+            switch (c) {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case '"': case '\\': case '/': break;
+                case 'u': {
+                    long codigo = lerHexadecimalJson(leitor);
+                    if (codigo < 0) return 0;
+                    // Par substituto (UTF-16): \uD8xx\uDCxx
+                    if (codigo >= 0xD800 && codigo < 0xDC00 && lerCaractere(leitor) == '\\' &&
+                        lerCaractere(leitor) == 'u') {
+                        long baixo = lerHexadecimalJson(leitor);
+                        if (baixo < 0xDC00 || baixo > 0xDFFF) return 0;
+                        codigo = 0x10000 + ((codigo - 0xD800) << 10) + (baixo - 0xDC00);
+                    }
+                    anexarUtf8(campo, &usados, (unsigned) codigo);
+                    continue;
+                }
+                default: return 0;
+            }
+        }
+        if (usados < TAMANHO_MAXIMO_CAMPO - 1) campo[usados++] = (char) c;
+    }
+    campo[usados] = '\0';
+    *tamanho = usados;
+    return 1;
+}
+
+// Lê um objeto do vetor JSON: {"nome": "...", "discos": 3, ...}.
+// Os valores são escalares (texto, número ou null); chaves desconhecidas são ignoradas.
+static int lerRegistroJson(Conversao* conversao, RegistroConversao* registro) {
+    LeitorBuffer* leitor = &conversao->leitor;
+    char chave[TAMANHO_MAXIMO_CAMPO];
+    char valor[TAMANHO_MAXIMO_CAMPO];
+    size_t tamanhoChave, tamanhoValor;
+
+    int c = pularEspacosJson(leitor);
+    if (c == ',') {
+        leitor->posicao++;
+        c = pularEspacosJson(leitor);
+    }
+    if (c == ']') {
+        return REGISTRO_FIM;
+    }
+    if (c != '{') {
+        return REGISTRO_ERRO;
+    }
+    leitor->posicao++;
+    unsigned presentes = 0;
+    int valido = 1;
+    c = pularEspacosJson(leitor);
+    while (c != '}') {
+        if (c != '"' || (leitor->posicao++, !lerTextoJson(leitor, chave, &tamanhoChave)) ||
+            pularEspacosJson(leitor) != ':') {
+            return REGISTRO_ERRO;
+        }
+        leitor->posicao++;
+        c = pularEspacosJson(leitor);
+        int nulo = 0;
+        if (c == '"') {
+            leitor->posicao++;
+            if (!lerTextoJson(leitor, valor, &tamanhoValor)) return REGISTRO_ERRO;
+        } else {
+            // Número, true, false ou null: até o próximo separador
+            tamanhoValor = 0;
+            while (c != ',' && c != '}' && c != ' ' && c != '\n' && c != '\r' && c != '\t' && c != EOF) {
+                if (tamanhoValor < TAMANHO_MAXIMO_CAMPO - 1) valor[tamanhoValor++] = (char) c;
+                leitor->posicao++;
+                c = espiarCaractere(leitor);
+            }
+            if (tamanhoValor == 0) return REGISTRO_ERRO;
+            valor[tamanhoValor] = '\0';
+            nulo = strcmp(valor, "null") == 0;
+        }
+        if (!nulo) {
+            valido &= aplicarCampo(registro, campoPeloNome(chave, tamanhoChave), valor, tamanhoValor, &presentes);
+        }
+        c = pularEspacosJson(leitor);
+        if (c == ',') {
+            leitor->posicao++;
+            c = pularEspacosJson(leitor);
+        } else if (c != '}') {
+            return REGISTRO_ERRO;
+        }
+    }
+    leitor->posicao++;
+    return valido ? finalizarRegistro(registro, presentes) : REGISTRO_INVALIDO;
+}
+
+// Lê o próximo registro da origem
+static int lerRegistro(Conversao* conversao, RegistroConversao* registro) {
+    memset(registro, 0, sizeof(RegistroConversao));
+    switch (conversao->formatoOrigem) {
+        case FORMATO_DAT:
+            if (conversao->registrosRestantes == 0) return REGISTRO_FIM;
+            conversao->registrosRestantes--;
+            if (!lerBytes(&conversao->leitor, &registro->partida, sizeof(Partida))) return REGISTRO_FIM;
+            registro->partida.nomeJogador[sizeof(registro->partida.nomeJogador) - 1] = '\0';
+            // Confere os limites como nos formatos de texto; o deslocamento dos movimentos
+            // aponta para o arquivo de movimentos da origem, então também é descartado
+            return finalizarRegistro(registro, (1u << NUM_CAMPOS) - 1);
+        case FORMATO_JSON:
+            return lerRegistroJson(conversao, registro);
+        default:
+            return lerRegistroDeLinha(conversao, registro);
+    }
+}
+
+// Prepara a leitura da origem (cabeçalho do .dat, cabeçalho do CSV, abertura do vetor JSON)
+static int iniciarLeitura(Conversao* conversao, const char* origem) {
+    if (conversao->formatoOrigem == FORMATO_DAT) {
+        CabecalhoHistorico cabecalho;
+        if (!lerBytes(&conversao->leitor, &cabecalho, sizeof(cabecalho)) ||
+            memcmp(cabecalho.magico, HISTORICO_MAGICO, sizeof(cabecalho.magico)) != 0 ||
+            cabecalho.versao != HISTORICO_VERSAO || cabecalho.tamanhoRegistro != sizeof(Partida)) {
+            fprintf(stderr, "Erro: %s nao esta no formato atual de historico (abra o jogo uma vez para converte-lo).\n",
+                    origem);
+            return 0;
+        }
+        conversao->registrosRestantes = cabecalho.numRegistros;
+        return 1;
+    }
+    if (conversao->formatoOrigem == FORMATO_CSV) {
+        return lerCabecalhoCsv(conversao);
+    }
+    if (conversao->formatoOrigem == FORMATO_JSON) {
+        if (pularEspacosJson(&conversao->leitor) != '[') {
+            fprintf(stderr, "Erro: %s deve conter um vetor JSON de partidas.\n", origem);
+            return 0;
+        }
+        conversao->leitor.posicao++;
+    }
+    return 1;
+}
+
+// Abre o .dat de destino: acrescenta a um histórico existente ou cria um novo
+static FILE* abrirDatDestino(Conversao* conversao, const char* destino) {
+    CabecalhoHistorico* cabecalho = &conversao->cabecalhoDestino;
+    FILE* arquivo = fopen(destino, "r+b");
+    if (arquivo != NULL && fread(cabecalho, sizeof(CabecalhoHistorico), 1, arquivo) == 1) {
+        if (memcmp(cabecalho->magico, HISTORICO_MAGICO, sizeof(cabecalho->magico)) != 0 ||
+            cabecalho->versao != HISTORICO_VERSAO || cabecalho->tamanhoRegistro != sizeof(Partida)) {
+            fprintf(stderr, "Erro: %s nao esta no formato atual de historico; nada foi gravado.\n", destino);
+            fclose(arquivo);
+            return NULL;
+        }
+        // Como anexarPartidaAoArquivo: grava depois do último registro válido
+        if (fseek(arquivo, (long)(sizeof(CabecalhoHistorico) + cabecalho->numRegistros * sizeof(Partida)),
+                  SEEK_SET) != 0) {
+            fclose(arquivo);
+            return NULL;
+        }
+        return arquivo;
+    }
+    if (arquivo != NULL) fclose(arquivo);
+    arquivo = fopen(destino, "w+b");
+    if (arquivo == NULL) {
+        return NULL;
+    }
+    memset(cabecalho, 0, sizeof(CabecalhoHistorico));
+    memcpy(cabecalho->magico, HISTORICO_MAGICO, sizeof(cabecalho->magico));
+    cabecalho->versao = HISTORICO_VERSAO;
+    cabecalho->tamanhoRegistro = (uint32_t) sizeof(Partida);
+    if (fwrite(cabecalho, sizeof(CabecalhoHistorico), 1, arquivo) != 1) {
+        fclose(arquivo);
+        return NULL;
+    }
+    return arquivo;
+}
+
+// Escreve um texto entre aspas no CSV se ele tiver vírgula, aspas ou quebra de linha
+static void escreverTextoCsv(EscritorBuffer* escritor, const char* texto) {
+    if (strpbrk(texto, ",\"\r\n") == NULL) {
+        escreverTexto(escritor, texto);
+        return;
+    }
+    escreverCaractere(escritor, '"');
+    for (const char* c = texto; *c != '\0'; c++) {
+        if (*c == '"') escreverCaractere(escritor, '"');
+        escreverCaractere(escritor, *c);
+    }
+    escreverCaractere(escritor, '"');
+}
+
+// Escreve um texto como string JSON (aspas, barras e caracteres de controle escapados)
+static void escreverTextoJson(EscritorBuffer* escritor, const char* texto) {
+    static const char hexadecimal[] = "0123456789abcdef";
+    escreverCaractere(escritor, '"');
+    for (const unsigned char* c = (const unsigned char*) texto; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            escreverCaractere(escritor, '\\');
+            escreverCaractere(escritor, (char) *c);
+        } else if (*c < 0x20) {
+            char escape[6] = {'\\', 'u', '0', '0', hexadecimal[*c >> 4], hexadecimal[*c & 0xF]};
+            escreverBytes(escritor, escape, sizeof(escape));
+        } else {
+            escreverCaractere(escritor, (char) *c);
+        }
+    }
+    escreverCaractere(escritor, '"');
+}
+
+// Grava um registro no destino; retorna 0 se o formato de destino não o representa
+static int escreverRegistro(Conversao* conversao, const RegistroConversao* registro) {
+    EscritorBuffer* escritor = &conversao->escritor;
+    const Partida* partida = &registro->partida;
+    long long valores[NUM_CAMPOS] = {0, partida->numDiscos, partida->numPinos, partida->numMovimentos,
+                                     partida->movimentosDesperdicados, 0};
+    switch (conversao->formatoDestino) {
+        case FORMATO_DAT:
+            escreverBytes(escritor, partida, sizeof(Partida));
+            conversao->cabecalhoDestino.numRegistros++;
+            return 1;
+        case FORMATO_V2:
+            // A V2 só tem 3 pinos, e ';' ou quebras de linha no nome quebrariam a linha
+            if (partida->numPinos != 3 || strpbrk(partida->nomeJogador, ";\r\n") != NULL) {
+                return 0;
+            }
+            escreverTexto(escritor, partida->nomeJogador);
+            escreverCaractere(escritor, ';');
+            escreverTexto(escritor, registro->data);
+            escreverCaractere(escritor, ';');
+            escreverInteiro(escritor, partida->numDiscos);
+            escreverCaractere(escritor, ';');
+            escreverInteiro(escritor, partida->numMovimentos);
+            escreverCaractere(escritor, '\n');
+            return 1;
+        case FORMATO_CSV:
+            for (int c = 0; c < NUM_CAMPOS; c++) {
+                if (c > 0) escreverCaractere(escritor, ',');
+                if (c == CAMPO_NOME) escreverTextoCsv(escritor, partida->nomeJogador);
+                else if (c == CAMPO_DATA) escreverTextoCsv(escritor, registro->data);
+                else escreverInteiro(escritor, valores[c]);
+            }
+            escreverCaractere(escritor, '\n');
+            return 1;
+        default:
+            escreverTexto(escritor, conversao->primeiroJson ? "{" : ",\n{");
+            conversao->primeiroJson = 0;
+            for (int c = 0; c < NUM_CAMPOS; c++) {
+                if (c > 0) escreverCaractere(escritor, ',');
+                escreverCaractere(escritor, '"');
+                escreverTexto(escritor, nomesDosCampos[c]);
+                escreverTexto(escritor, "\":");
+                if (c == CAMPO_NOME) escreverTextoJson(escritor, partida->nomeJogador);
+                else if (c == CAMPO_DATA) escreverTextoJson(escritor, registro->data);
+                else escreverInteiro(escritor, valores[c]);
+            }
+            escreverCaractere(escritor, '}');
+            return 1;
+    }
+}
+
+/**
+ * @brief Identifica o formato de um histórico pela extensão do arquivo.
+ * @return .dat, .txt (V2), .csv ou .json; FORMATO_DESCONHECIDO para as demais.
+ */
+FormatoHistorico formatoPelaExtensao(const char* caminho) {
+    static const char* const extensoes[] = {".dat", ".txt", ".csv", ".json"};
+    size_t tamanho = strlen(caminho);
+    for (int f = 0; f < FORMATO_DESCONHECIDO; f++) {
+        size_t tamanhoExtensao = strlen(extensoes[f]);
+        if (tamanho > tamanhoExtensao) {
+            const char* extensao = caminho + tamanho - tamanhoExtensao;
+            size_t i = 0;
+            while (i < tamanhoExtensao && (extensao[i] | 0x20) == extensoes[f][i]) i++;
+            if (i == tamanhoExtensao) return (FormatoHistorico) f;
+        }
+    }
+    return FORMATO_DESCONHECIDO;
+}
+
+// Retorna 1 se os dois caminhos levam ao mesmo arquivo (ex: "e.csv" e "./e.csv"), que o
+// destino truncaria antes da leitura. Sem stat, compara só os nomes.
+static int mesmoArquivo(const char* origem, const char* destino) {
+#ifndef _WIN32
+    struct stat infoOrigem, infoDestino;
+    if (stat(origem, &infoOrigem) == 0 && stat(destino, &infoDestino) == 0) {
+        return infoOrigem.st_dev == infoDestino.st_dev && infoOrigem.st_ino == infoDestino.st_ino;
+    }
+#endif
+    return strcmp(origem, destino) == 0;
+}
+
+/**
+ * @brief Converte um histórico entre formatos, um registro por vez.
+ * * Lê e escreve em blocos de CONVERSAO_TAMANHO_BUFFER bytes e interpreta os campos
+ * * à mão (sem sscanf/fprintf por linha), então a memória usada é constante e a
+ * * vazão fica perto da do disco, qualquer que seja o tamanho do histórico.
+ * * Um .dat de destino existente recebe os registros no fim (como o jogo faz); os
+ * * demais destinos são sobrescritos. Registros inválidos, ou que o destino não
+ * * representa (V2 só tem 3 pinos), são contados e pulados.
+ * @param origem O histórico de origem (formato pela extensão).
+ * @param destino O arquivo de destino (formato pela extensão).
+ * @param estatisticas Recebe as contagens e o tempo da conversão (pode ser NULL).
+ * @return 1 em caso de sucesso, 0 em caso de erro.
+ */
+int converterHistorico(const char* origem, const char* destino, EstatisticasConversao* estatisticas) {
+    Conversao conversao;
+    memset(&conversao, 0, sizeof(conversao));
+    conversao.formatoOrigem = formatoPelaExtensao(origem);
+    conversao.formatoDestino = formatoPelaExtensao(destino);
+    conversao.primeiroJson = 1;
+    if (conversao.formatoOrigem == FORMATO_DESCONHECIDO || conversao.formatoDestino == FORMATO_DESCONHECIDO) {
+        fprintf(stderr, "Erro: use arquivos .dat, .txt (versao 2), .csv ou .json.\n");
+        return 0;
+    }
+    if (mesmoArquivo(origem, destino)) {
+        fprintf(stderr, "Erro: a origem e o destino sao o mesmo arquivo.\n");
+        return 0;
+    }
+
+    double inicio = cronometroSegundos();
+    conversao.leitor.arquivo = fopen(origem, "rb");
+    if (conversao.leitor.arquivo == NULL) {
+        perror("Erro ao abrir o historico de origem");
+        return 0;
+    }
+    conversao.escritor.arquivo = (conversao.formatoDestino == FORMATO_DAT) ? abrirDatDestino(&conversao, destino)
+                                                                           : fopen(destino, "wb");
+    conversao.leitor.dados = (unsigned char*) malloc(CONVERSAO_TAMANHO_BUFFER);
+    conversao.escritor.dados = (char*) malloc(CONVERSAO_TAMANHO_BUFFER);
+    int ok = 0;
+    if (conversao.escritor.arquivo == NULL) {
+        perror("Erro ao abrir o arquivo de destino");
+    } else if (conversao.leitor.dados == NULL || conversao.escritor.dados == NULL) {
+        perror("Erro ao alocar memoria para a conversao");
+    } else if (iniciarLeitura(&conversao, origem)) {
+        EstatisticasConversao contagem = {0, 0, 0.0};
+        RegistroConversao registro;
+        int situacao;
+        if (conversao.formatoDestino == FORMATO_CSV) {
+            for (int c = 0; c < NUM_CAMPOS; c++) {
+                if (c > 0) escreverCaractere(&conversao.escritor, ',');
+                escreverTexto(&conversao.escritor, nomesDosCampos[c]);
+            }
+            escreverCaractere(&conversao.escritor, '\n');
+        } else if (conversao.formatoDestino == FORMATO_JSON) {
+            escreverTexto(&conversao.escritor, "[\n");
+        }
+        while ((situacao = lerRegistro(&conversao, &registro)) != REGISTRO_FIM && situacao != REGISTRO_ERRO) {
+            if (situacao == REGISTRO_LIDO && escreverRegistro(&conversao, &registro)) {
+                contagem.convertidos++;
+            } else {
+                contagem.ignorados++;
+            }
+        }
+        if (conversao.formatoDestino == FORMATO_JSON) {
+            escreverTexto(&conversao.escritor, conversao.primeiroJson ? "]\n" : "\n]\n");
+        }
+        esvaziarEscritor(&conversao.escritor);
+        if (conversao.formatoDestino == FORMATO_DAT && !conversao.escritor.erro) {
+            // Só agora o contador do cabeçalho passa a incluir os registros novos
+            conversao.escritor.erro = fflush(conversao.escritor.arquivo) != 0 ||
+                                      fseek(conversao.escritor.arquivo, 0, SEEK_SET) != 0 ||
+                                      fwrite(&conversao.cabecalhoDestino, sizeof(CabecalhoHistorico), 1,
+                                             conversao.escritor.arquivo) != 1;
+        }
+        if (situacao == REGISTRO_ERRO) {
+            fprintf(stderr, "Erro: %s esta malformado depois de %llu registros.\n", origem,
+                    contagem.convertidos + contagem.ignorados);
+        }
+        contagem.segundos = cronometroSegundos() - inicio;
+        if (estatisticas != NULL) *estatisticas = contagem;
+        ok = (situacao != REGISTRO_ERRO) && !conversao.escritor.erro;
+    }
+    if (conversao.escritor.arquivo != NULL && fclose(conversao.escritor.arquivo) != 0) {
+        ok = 0;
+    }
+    if (conversao.escritor.erro) {
+        perror("Erro ao gravar o arquivo de destino");
+    }
+    fclose(conversao.leitor.arquivo);
+    free(conversao.escritor.dados);
+    free(conversao.leitor.dados);
+    return ok;
+}
+
+/**
+ * @brief Converte um histórico e imprime as contagens e a vazão.
+ * @return 0 em caso de sucesso, 1 em caso de erro.
+ */
+int executarConversao(const char* origem, const char* destino) {
+    EstatisticasConversao estatisticas = {0, 0, 0.0};
+    if (!converterHistorico(origem, destino, &estatisticas)) {
+        return 1;
+    }
+    double segundos = (estatisticas.segundos > 0) ? estatisticas.segundos : 1e-9;
+    printf("%llu registros convertidos, %llu ignorados, %.3f s (%.0f registros/s)\n", estatisticas.convertidos,
+           estatisticas.ignorados, estatisticas.segundos,
+           (double)(estatisticas.convertidos + estatisticas.ignorados) / segundos);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef CONVERSAO_H
+#define CONVERSAO_H
+
+#include "historico.h" // Para Partida
+
+// Tamanho dos buffers de leitura e de escrita da conversão (memória constante, qualquer que seja o histórico)
+#define CONVERSAO_TAMANHO_BUFFER (1 << 20)
+
+// Formatos de histórico reconhecidos pela extensão do arquivo
+typedef enum {
+    FORMATO_DAT,   // .dat: historico.dat binário do jogo (versão atual)
+    FORMATO_V2,    // .txt: historico.txt da versão 2, linhas "nome;data;discos;movimentos"
+    FORMATO_CSV,   // .csv: cabeçalho com os nomes das colunas (ver conversao.c)
+    FORMATO_JSON,  // .json: vetor de objetos com as mesmas chaves do CSV
+    FORMATO_DESCONHECIDO
+} FormatoHistorico;
+
+// Uma partida em trânsito entre formatos
+typedef struct {
+    Partida partida;
+    char data[11]; // Data da partida ("DD/MM/AAAA"); só a V2 registra, vazia nos demais formatos
+} RegistroConversao;
+
+// Medidas de uma conversão
+typedef struct {
+    unsigned long long convertidos; // Registros gravados no destino
+    unsigned long long ignorados;   // Registros inválidos ou que o destino não representa
+    double segundos;
+} EstatisticasConversao;
+
+// Protótipos da conversão de históricos
+FormatoHistorico formatoPelaExtensao(const char* caminho);
+int converterHistorico(const char* origem, const char* destino, EstatisticasConversao* estatisticas);
+int executarConversao(const char* origem, const char* destino);
+
+#endif // CONVERSAO_H
@@ -0,0 +1,51 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L // Para clock_gettime
+#endif
+
+#include "cronometro.h"
+
+#ifdef _WIN32
+#include <windows.h> // Para QueryPerformanceCounter
+#else
+#include <time.h>
+#endif
+
+/**
+ * @brief Lê o relógio monotônico de alta resolução do sistema.
+ * @return O instante atual em segundos (a origem é arbitrária; use apenas diferenças).
+ */
+double cronometroSegundos() {
+#ifdef _WIN32
+    static LARGE_INTEGER frequencia;
+    LARGE_INTEGER contador;
+    if (frequencia.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequencia);
+    }
+    QueryPerformanceCounter(&contador);
+    return (double)contador.QuadPart / (double)frequencia.QuadPart;
+#else
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (double)agora.tv_sec + (double)agora.tv_nsec / 1e9;
+#endif
+}
+
+/**
+ * @brief Suspende a execução da thread atual.
+ * @param milissegundos O tempo de espera; valores menores ou iguais a zero retornam na hora.
+ */
+void cronometroEsperar(int milissegundos) {
+    if (milissegundos <= 0) {
+        return;
+    }
+#ifdef _WIN32
+    Sleep((DWORD) milissegundos);
+#else
+    struct timespec espera;
+    espera.tv_sec = milissegundos / 1000;
+    espera.tv_nsec = (long)(milissegundos % 1000) * 1000000L;
+    while (nanosleep(&espera, &espera) != 0) {
+        // Interrompido por um sinal: continua esperando o tempo restante
+    }
+#endif
+}
@@ -0,0 +1,10 @@
+#ifndef CRONOMETRO_H
+#define CRONOMETRO_H
+
+// Retorna um instante em segundos de um relógio monotônico (útil para medir intervalos)
+double cronometroSegundos();
+
+// Suspende a execução por alguns milissegundos (usado para controlar a velocidade da reprodução)
+void cronometroEsperar(int milissegundos);
+
+#endif // CRONOMETRO_H
@@ -0,0 +1,103 @@
+#include "estado.h"
+#include <string.h> // Para memset
+
+#if !(defined(__GNUC__) || defined(__clang__))
+/**
+ * @brief Versões portáveis das operações de bits para compiladores sem builtins.
+ */
+int estadoBitMaisBaixo(uint64_t mascara) {
+    int indice = 0;
+    while ((mascara & 1) == 0) {
+        mascara >>= 1;
+        indice++;
+    }
+    return indice;
+}
+
+int estadoContarBits(uint64_t mascara) {
+    int total = 0;
+    while (mascara != 0) {
+        mascara &= mascara - 1; // Desliga o bit mais baixo
+        total++;
+    }
+    return total;
+}
+
+int estadoBitMaisAlto(uint64_t mascara) {
+    int indice = -1;
+    while (mascara != 0) {
+        mascara >>= 1;
+        indice++;
+    }
+    return indice;
+}
+#endif
+
+/**
+ * @brief Inicializa o estado com todos os discos empilhados em um pino.
+ * @param estado O estado a ser inicializado.
+ * @param numDiscos O número de discos da partida (1 a ESTADO_MAX_DISCOS).
+ * @param numPinos O número de pinos da partida (ESTADO_MIN_PINOS a ESTADO_MAX_PINOS).
+ * @param pinoInicial O índice do pino que recebe todos os discos.
+ */
+void inicializarEstado(EstadoTorres* estado, int numDiscos, int numPinos, int pinoInicial) {
+    memset(estado, 0, sizeof(EstadoTorres));
+    estado->numDiscos = numDiscos;
+    estado->numPinos = numPinos;
+    estado->pinos[pinoInicial] = estadoMascaraCompleta(numDiscos);
+}
+
+/**
+ * @brief Verifica se o movimento do disco do topo de 'origem' para 'destino' é permitido.
+ * * O pino de origem não pode estar vazio e o disco movido deve ser menor que
+ * * o topo do destino. Como o topo é o bit mais baixo, basta comparar os bits mais baixos.
+ * @return 1 se o movimento for válido, 0 caso contrário.
+ */
+int estadoMovimentoValido(const EstadoTorres* estado, int origem, int destino) {
+    if (origem < 0 || origem >= estado->numPinos || destino < 0 || destino >= estado->numPinos || origem == destino) {
+        return 0;
+    }
+    uint64_t pinoOrigem = estado->pinos[origem];
+    uint64_t pinoDestino = estado->pinos[destino];
+    if (pinoOrigem == 0) {
+        return 0;
+    }
+    // (x & -x) isola o bit mais baixo: o disco da origem precisa ser menor que o do destino
+    return pinoDestino == 0 || (pinoOrigem & (0 - pinoOrigem)) < (pinoDestino & (0 - pinoDestino));
+}
+
+/**
+ * @brief Move o disco do topo de 'origem' para 'destino', se o movimento for válido.
+ * @return O tamanho do disco movido, ou -1 se o movimento for inválido.
+ */
+int estadoMover(EstadoTorres* estado, int origem, int destino) {
+    if (!estadoMovimentoValido(estado, origem, destino)) {
+        return -1;
+    }
+    uint64_t bitDisco = estado->pinos[origem] & (0 - estado->pinos[origem]);
+    estado->pinos[origem] ^= bitDisco;  // Retira o disco da origem
+    estado->pinos[destino] |= bitDisco; // Coloca o disco no destino
+    return ESTADO_BIT_MAIS_BAIXO(bitDisco) + 1;
+}
+
+/**
+ * @brief Verifica a condição de vitória: todos os discos no pino de destino.
+ * * A ordem dos discos é garantida pela própria representação em bits.
+ * @return 1 se o jogo estiver concluído, 0 caso contrário.
+ */
+int estadoConcluido(const EstadoTorres* estado, int pinoDestino) {
+    return estado->pinos[pinoDestino] == estadoMascaraCompleta(estado->numDiscos);
+}
+
+/**
+ * @brief Retorna o índice do pino onde está o disco informado, ou -1 se não for encontrado.
+ */
+int estadoPinoDoDisco(const EstadoTorres* estado, int tamanhoDisco) {
+    uint64_t bitDisco = (uint64_t)1 << (tamanhoDisco - 1);
+    for (int i = 0; i < estado->numPinos; i++) {
+        if (estado->pinos[i] & bitDisco) {
+            return i;
+        }
+    }
+    return -1;
+}
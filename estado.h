@@ -0,0 +1,55 @@
+#ifndef ESTADO_H
+#define ESTADO_H
+
+#include <stdint.h> // Para uint64_t
+
+// Constantes do motor de estado compacto (bitboard)
+#define ESTADO_MAX_DISCOS 64   // Um disco por bit de uma palavra de 64 bits
+#define ESTADO_MIN_PINOS 3     // Menor número de pinos de uma partida
+#define ESTADO_MAX_PINOS 8     // Maior número de pinos de uma partida (A a H)
+
+// Estado compacto das torres: cada pino é uma máscara de bits.
+// O bit (d - 1) ligado em pinos[p] significa que o disco de tamanho d está no pino p.
+// Como os discos de um pino estão sempre ordenados, o topo é o bit ligado mais baixo.
+typedef struct {
+    uint64_t pinos[ESTADO_MAX_PINOS]; // Máscara de discos de cada pino (só os numPinos primeiros são usados)
+    int numDiscos;                    // Número total de discos da partida
+    int numPinos;                     // Número de pinos da partida (ESTADO_MIN_PINOS a ESTADO_MAX_PINOS)
+} EstadoTorres;
+
+// Índice do bit ligado mais baixo (a máscara NÃO pode ser zero)
+#if defined(__GNUC__) || defined(__clang__)
+#define ESTADO_BIT_MAIS_BAIXO(mascara) __builtin_ctzll(mascara)
+#define ESTADO_CONTAR_BITS(mascara) __builtin_popcountll(mascara)
+#define ESTADO_BIT_MAIS_ALTO(mascara) (63 - __builtin_clzll(mascara))
+#else
+int estadoBitMaisBaixo(uint64_t mascara);
+int estadoContarBits(uint64_t mascara);
+int estadoBitMaisAlto(uint64_t mascara);
+#define ESTADO_BIT_MAIS_BAIXO(mascara) estadoBitMaisBaixo(mascara)
+#define ESTADO_CONTAR_BITS(mascara) estadoContarBits(mascara)
+#define ESTADO_BIT_MAIS_ALTO(mascara) estadoBitMaisAlto(mascara)
+#endif
+
+/**
+ * @brief Retorna a máscara com os discos 1..numDiscos ligados.
+ */
+static inline uint64_t estadoMascaraCompleta(int numDiscos) {
+    return (numDiscos >= ESTADO_MAX_DISCOS) ? ~(uint64_t)0 : (((uint64_t)1 << numDiscos) - 1);
+}
+
+/**
+ * @brief Retorna o tamanho do disco no topo de um pino, ou -1 se o pino estiver vazio.
+ */
+static inline int estadoTopoDoPino(uint64_t pino) {
+    return (pino == 0) ? -1 : ESTADO_BIT_MAIS_BAIXO(pino) + 1;
+}
+
+// Protótipos das funções do estado compacto
+void inicializarEstado(EstadoTorres* estado, int numDiscos, int numPinos, int pinoInicial);
+int estadoMovimentoValido(const EstadoTorres* estado, int origem, int destino);
+int estadoMover(EstadoTorres* estado, int origem, int destino);
+int estadoConcluido(const EstadoTorres* estado, int pinoDestino);
+int estadoPinoDoDisco(const EstadoTorres* estado, int tamanhoDisco);
+
+#endif // ESTADO_H
@@ -0,0 +1,304 @@
+#include "explorador.h"
+#include "cronometro.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+// Marca de "sem destino": a busca percorre o grafo inteiro
+#define SEM_DESTINO UINT64_MAX
+
+// Maior caminho impresso por executarExplorador
+#define LIMITE_IMPRESSAO_CAMINHO 1000
+
+// Capacidade inicial das fronteiras (crescem dobrando)
+#define FRONTEIRA_INICIAL 1024
+
+// 3^d para d = 0..EXPLORADOR_MAX_DISCOS
+static uint64_t potencia3[EXPLORADOR_MAX_DISCOS + 1];
+
+static void prepararPotencias() {
+    if (potencia3[0] != 0) {
+        return;
+    }
+    potencia3[0] = 1;
+    for (int d = 1; d <= EXPLORADOR_MAX_DISCOS; d++) {
+        potencia3[d] = potencia3[d - 1] * 3;
+    }
+}
+
+// Pino do disco de tamanho d no estado compactado
+static inline int pinoDoDisco(EstadoCompacto compacto, int d) {
+    return (int)((compacto >> (2 * (d - 1))) & 3);
+}
+
+// Menor disco de cada pino (0 se o pino estiver vazio)
+static inline void toposDoEstado(EstadoCompacto compacto, int numDiscos, int topos[3]) {
+    topos[0] = topos[1] = topos[2] = 0;
+    int encontrados = 0;
+    for (int d = 1; d <= numDiscos && encontrados < 3; d++) {
+        int pino = pinoDoDisco(compacto, d);
+        if (topos[pino] == 0) {
+            topos[pino] = d;
+            encontrados++;
+        }
+    }
+}
+
+/**
+ * @brief Compacta um estado de 3 pinos em 2 bits por disco.
+ */
+EstadoCompacto compactarEstado(const EstadoTorres* estado) {
+    EstadoCompacto compacto = 0;
+    for (int d = 1; d <= estado->numDiscos; d++) {
+        uint64_t bitDisco = (uint64_t)1 << (d - 1);
+        uint64_t pino = (estado->pinos[0] & bitDisco) ? 0 : (estado->pinos[1] & bitDisco) ? 1 : 2;
+        compacto |= pino << (2 * (d - 1));
+    }
+    return compacto;
+}
+
+/**
+ * @brief Reconstrói o estado em bitboards a partir da forma compactada.
+ */
+void descompactarEstado(EstadoCompacto compacto, int numDiscos, EstadoTorres* estado) {
+    inicializarEstado(estado, numDiscos, 3, 0);
+    estado->pinos[0] = 0;
+    for (int d = 1; d <= numDiscos; d++) {
+        estado->pinos[pinoDoDisco(compacto, d)] |= (uint64_t)1 << (d - 1);
+    }
+}
+
+/**
+ * @brief Converte o estado compactado no índice base 3 (0 a 3^n - 1) usado pelo vetor de visitados.
+ */
+uint64_t indiceBase3(EstadoCompacto compacto, int numDiscos) {
+    prepararPotencias();
+    uint64_t indice = 0;
+    for (int d = 1; d <= numDiscos; d++) {
+        indice += (uint64_t) pinoDoDisco(compacto, d) * potencia3[d - 1];
+    }
+    return indice;
+}
+
+/**
+ * @brief Lê uma posição escrita como uma letra de pino por disco, do menor para o maior.
+ * * Exemplo: "ABC" com 3 discos = disco 1 no pino A, disco 2 no B e disco 3 no C.
+ * @return 1 se o texto for válido, 0 caso contrário.
+ */
+int lerEstadoCompacto(const char* texto, int numDiscos, EstadoCompacto* compacto) {
+    if ((int) strlen(texto) != numDiscos) {
+        return 0;
+    }
+    *compacto = 0;
+    for (int d = 1; d <= numDiscos; d++) {
+        int pino = toupper((unsigned char) texto[d - 1]) - 'A';
+        if (pino < 0 || pino > 2) {
+            return 0;
+        }
+        *compacto |= (EstadoCompacto) pino << (2 * (d - 1));
+    }
+    return 1;
+}
+
+// Vetor plano de estados de um nível da busca
+typedef struct {
+    EstadoCompacto* itens;
+    size_t quantidade;
+    size_t capacidade;
+} Fronteira;
+
+static int acrescentarNaFronteira(Fronteira* fronteira, EstadoCompacto estado) {
+    if (fronteira->quantidade == fronteira->capacidade) {
+        size_t novaCapacidade = (fronteira->capacidade == 0) ? FRONTEIRA_INICIAL : fronteira->capacidade * 2;
+        EstadoCompacto* novosItens = (EstadoCompacto*) realloc(fronteira->itens, novaCapacidade * sizeof(EstadoCompacto));
+        if (novosItens == NULL) {
+            return 0;
+        }
+        fronteira->itens = novosItens;
+        fronteira->capacidade = novaCapacidade;
+    }
+    fronteira->itens[fronteira->quantidade++] = estado;
+    return 1;
+}
+
+/**
+ * @brief Busca em largura sobre o grafo completo de 3^n estados (3 pinos).
+ * * Os visitados ficam em um vetor de bits indexado pelo índice base 3 e cada nível da busca
+ * * é um vetor plano de estados compactados. Para reconstruir o caminho, cada estado guarda
+ * * em um byte o movimento pelo qual foi alcançado.
+ * @param numDiscos O número de discos (1 a EXPLORADOR_MAX_DISCOS).
+ * @param origem A posição de partida.
+ * @param destino A posição de chegada; SEM_DESTINO percorre o grafo inteiro.
+ * @param caminho Vetor de saída para os movimentos (pode ser NULL).
+ * @param capacidade Quantos movimentos cabem em 'caminho'; caminhos maiores não são copiados.
+ * @param estatisticas Recebe as medidas da busca (pode ser NULL).
+ * @return O tamanho do menor caminho (ou a maior distância a partir da origem, sem destino),
+ *         ou -1 em caso de erro.
+ */
+long long menorCaminho(int numDiscos, EstadoCompacto origem, EstadoCompacto destino,
+                       Movimento* caminho, size_t capacidade, EstatisticasExplorador* estatisticas) {
+    if (numDiscos < 1 || numDiscos > EXPLORADOR_MAX_DISCOS) {
+        fprintf(stderr, "Erro: o explorador aceita de 1 a %d discos.\n", EXPLORADOR_MAX_DISCOS);
+        return -1;
+    }
+    prepararPotencias();
+    uint64_t totalEstados = potencia3[numDiscos];
+    int buscarTudo = (destino == SEM_DESTINO);
+
+    size_t bytesVisitados = (size_t)((totalEstados + 63) / 64) * sizeof(uint64_t);
+    size_t bytesChegada = buscarTudo ? 0 : (size_t) totalEstados;
+    uint64_t* visitados = (uint64_t*) calloc(1, bytesVisitados);
+    unsigned char* chegada = buscarTudo ? NULL : (unsigned char*) malloc(bytesChegada);
+    Fronteira atual = {NULL, 0, 0}, proxima = {NULL, 0, 0};
+    if (visitados == NULL || (!buscarTudo && chegada == NULL) || !acrescentarNaFronteira(&atual, origem)) {
+        perror("Erro ao alocar memoria para o explorador");
+        free(visitados);
+        free(chegada);
+        free(atual.itens);
+        return -1;
+    }
+    uint64_t indiceOrigem = indiceBase3(origem, numDiscos);
+    visitados[indiceOrigem / 64] |= (uint64_t)1 << (indiceOrigem % 64);
+
+    size_t memoriaPico = 0;
+    uint64_t estadosVisitados = 0;
+    int profundidade = 0;
+    int encontrado = (origem == destino);
+    int erro = 0;
+    double inicio = cronometroSegundos();
+
+    while (!encontrado && !erro && atual.quantidade > 0) {
+        proxima.quantidade = 0;
+        for (size_t i = 0; i < atual.quantidade && !encontrado && !erro; i++) {
+            EstadoCompacto estado = atual.itens[i];
+            uint64_t indice = indiceBase3(estado, numDiscos);
+            int topos[3];
+            toposDoEstado(estado, numDiscos, topos);
+            estadosVisitados++;
+
+            for (int o = 0; o < 3; o++) {
+                if (topos[o] == 0) continue;
+                for (int d = 0; d < 3; d++) {
+                    if (d == o || (topos[d] != 0 && topos[d] < topos[o])) continue;
+                    int disco = topos[o];
+                    // Trocar o pino do disco: XOR nos 2 bits dele e ajuste do índice base 3
+                    EstadoCompacto vizinho = estado ^ ((EstadoCompacto)(o ^ d) << (2 * (disco - 1)));
+                    uint64_t indiceVizinho = indice + (uint64_t) d * potencia3[disco - 1] - (uint64_t) o * potencia3[disco - 1];
+                    uint64_t bit = (uint64_t)1 << (indiceVizinho % 64);
+                    if (visitados[indiceVizinho / 64] & bit) continue;
+                    visitados[indiceVizinho / 64] |= bit;
+                    if (chegada != NULL) {
+                        chegada[indiceVizinho] = (unsigned char)(o * 3 + d);
+                    }
+                    if (vizinho == destino) {
+                        encontrado = 1;
+                        break;
+                    }
+                    if (!acrescentarNaFronteira(&proxima, vizinho)) {
+                        erro = 1;
+                        break;
+                    }
+                }
+                if (encontrado || erro) break;
+            }
+        }
+        size_t memoria = bytesVisitados + bytesChegada + (atual.capacidade + proxima.capacidade) * sizeof(EstadoCompacto);
+        if (memoria > memoriaPico) memoriaPico = memoria;
+        if (encontrado || proxima.quantidade > 0) {
+            profundidade++;
+        }
+        Fronteira temp = atual; // O próximo nível vira o atual, reaproveitando os dois vetores
+        atual = proxima;
+        proxima = temp;
+    }
+    double segundos = cronometroSegundos() - inicio;
+
+    long long resultado = -1;
+    if (erro) {
+        perror("Erro ao alocar memoria para a fronteira do explorador");
+    } else if (buscarTudo) {
+        resultado = profundidade; // Maior distância a partir da origem
+    } else if (encontrado) {
+        // Volta do destino até a origem desfazendo o movimento de chegada de cada estado
+        resultado = profundidade;
+        EstadoCompacto estado = destino;
+        for (long long passo = profundidade; passo > 0; passo--) {
+            int codigo = chegada[indiceBase3(estado, numDiscos)];
+            int o = codigo / 3, d = codigo % 3;
+            int topos[3];
+            toposDoEstado(estado, numDiscos, topos);
+            if (caminho != NULL && (size_t) profundidade <= capacidade) {
+                caminho[passo - 1].origem = (unsigned char) o;
+                caminho[passo - 1].destino = (unsigned char) d;
+            }
+            estado ^= (EstadoCompacto)(o ^ d) << (2 * (topos[d] - 1));
+        }
+    }
+
+    if (estatisticas != NULL) {
+        estatisticas->estadosVisitados = estadosVisitados;
+        estatisticas->totalEstados = totalEstados;
+        estatisticas->profundidade = profundidade;
+        estatisticas->segundos = segundos;
+        estatisticas->memoriaPico = memoriaPico;
+    }
+    free(visitados);
+    free(chegada);
+    free(atual.itens);
+    free(proxima.itens);
+    return resultado;
+}
+
+/**
+ * @brief Modo explorador: menor caminho entre duas posições, ou exploração do grafo inteiro.
+ * * As posições são escritas com uma letra por disco, do menor para o maior ("AAA", "CBA", ...).
+ * @param numDiscos O número de discos.
+ * @param origem A posição de partida; NULL para todos os discos no pino A.
+ * @param destino A posição de chegada; NULL para percorrer todos os estados a partir da origem.
+ * @return 0 em caso de sucesso, 1 em caso de erro.
+ */
+int executarExplorador(int numDiscos, const char* origem, const char* destino) {
+    if (numDiscos < 1 || numDiscos > EXPLORADOR_MAX_DISCOS) {
+        fprintf(stderr, "Erro: o explorador aceita de 1 a %d discos.\n", EXPLORADOR_MAX_DISCOS);
+        return 1;
+    }
+    EstadoCompacto estadoOrigem = 0, estadoDestino = SEM_DESTINO;
+    if ((origem != NULL && !lerEstadoCompacto(origem, numDiscos, &estadoOrigem)) ||
+        (destino != NULL && !lerEstadoCompacto(destino, numDiscos, &estadoDestino))) {
+        fprintf(stderr, "Erro: posicao invalida. Use uma letra (A, B ou C) por disco, do menor para o maior.\n");
+        return 1;
+    }
+
+    Movimento* caminho = (Movimento*) malloc(LIMITE_IMPRESSAO_CAMINHO * sizeof(Movimento));
+    if (caminho == NULL) {
+        perror("Erro ao alocar memoria para o caminho");
+        return 1;
+    }
+    EstatisticasExplorador estatisticas;
+    long long tamanho = menorCaminho(numDiscos, estadoOrigem, estadoDestino, caminho, LIMITE_IMPRESSAO_CAMINHO,
+                                     &estatisticas);
+    if (tamanho < 0) {
+        free(caminho);
+        return 1;
+    }
+    if (destino == NULL) {
+        printf("Maior distancia a partir da origem: %lld movimentos\n", tamanho);
+    } else {
+        printf("Menor caminho: %lld movimentos\n", tamanho);
+        if (tamanho <= LIMITE_IMPRESSAO_CAMINHO) {
+            for (long long i = 0; i < tamanho; i++) {
+                printf("%c%c ", 'A' + caminho[i].origem, 'A' + caminho[i].destino);
+            }
+            printf("\n");
+        }
+    }
+    free(caminho);
+
+    fprintf(stderr, "Estados visitados: %llu de %llu\n", (unsigned long long) estatisticas.estadosVisitados,
+            (unsigned long long) estatisticas.totalEstados);
+    fprintf(stderr, "Tempo: %.3f s (%.0f estados/s)\n", estatisticas.segundos,
+            estatisticas.segundos > 0 ? (double) estatisticas.estadosVisitados / estatisticas.segundos : 0.0);
+    fprintf(stderr, "Memoria de pico: %.1f MB\n", (double) estatisticas.memoriaPico / (1024.0 * 1024.0));
+    return 0;
+}
@@ -0,0 +1,35 @@
+#ifndef EXPLORADOR_H
+#define EXPLORADOR_H
+
+#include <stddef.h> // Para size_t
+#include <stdint.h> // Para uint64_t
+#include "estado.h"
+#include "solucionador.h" // Para Movimento
+
+// Maior número de discos do explorador: o grafo tem 3^n estados e cada um ocupa
+// 1 bit (visitados) + 1 byte (movimento de chegada). Para 16 discos: cerca de 49 MB.
+#define EXPLORADOR_MAX_DISCOS 16
+
+// Estado compactado de uma partida de 3 pinos: 2 bits por disco.
+// Os bits 2(d-1) e 2(d-1)+1 guardam o pino (0, 1 ou 2) do disco de tamanho d.
+typedef uint64_t EstadoCompacto;
+
+// Medidas de uma busca em largura
+typedef struct {
+    uint64_t estadosVisitados; // Estados retirados da fronteira
+    uint64_t totalEstados;     // 3^n
+    int profundidade;          // Nível da busca quando ela terminou
+    double segundos;           // Tempo da busca
+    size_t memoriaPico;        // Maior soma de bytes alocados ao mesmo tempo
+} EstatisticasExplorador;
+
+// Protótipos do explorador do grafo de estados
+EstadoCompacto compactarEstado(const EstadoTorres* estado);
+void descompactarEstado(EstadoCompacto compacto, int numDiscos, EstadoTorres* estado);
+uint64_t indiceBase3(EstadoCompacto compacto, int numDiscos);
+int lerEstadoCompacto(const char* texto, int numDiscos, EstadoCompacto* compacto);
+long long menorCaminho(int numDiscos, EstadoCompacto origem, EstadoCompacto destino,
+                       Movimento* caminho, size_t capacidade, EstatisticasExplorador* estatisticas);
+int executarExplorador(int numDiscos, const char* origem, const char* destino);
+
+#endif // EXPLORADOR_H
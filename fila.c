@@ -0,0 +1,72 @@
+#include "fila.h"
+#include <stddef.h>
+
+// Operações atômicas (builtins do GCC/Clang, disponíveis também no MinGW)
+#define ATOMICO_TROCAR(ptr, valor) __atomic_exchange_n((ptr), (valor), __ATOMIC_SEQ_CST)
+#define ATOMICO_LER(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define ATOMICO_ESCREVER(ptr, valor) __atomic_store_n((ptr), (valor), __ATOMIC_RELEASE)
+
+/**
+ * @brief Prepara uma fila vazia (apenas a sentinela).
+ */
+void inicializarFila(FilaMPSC* fila) {
+    fila->sentinela.proximo = NULL;
+    fila->cauda = &fila->sentinela;
+    fila->cabeca = &fila->sentinela;
+}
+
+/**
+ * @brief Insere um nó no fim da fila; pode ser chamada por várias threads ao mesmo tempo.
+ * * A troca atômica da cauda ordena os produtores; o encadeamento ao nó anterior vem logo
+ * * depois, e até lá o consumidor apenas enxerga a fila como temporariamente mais curta.
+ * @param fila A fila.
+ * @param no O nó a inserir (não pode estar em outra fila).
+ */
+void inserirNaFila(FilaMPSC* fila, NoFila* no) {
+    no->proximo = NULL;
+    NoFila* anterior = ATOMICO_TROCAR(&fila->cauda, no);
+    ATOMICO_ESCREVER(&anterior->proximo, no);
+}
+
+/**
+ * @brief Retira o nó mais antigo da fila (somente a thread consumidora).
+ * @return O nó retirado, ou NULL se a fila está vazia ou se a última inserção
+ *         ainda não terminou de encadear o nó (basta tentar de novo).
+ */
+NoFila* retirarDaFila(FilaMPSC* fila) {
+    NoFila* cabeca = fila->cabeca;
+    NoFila* proximo = ATOMICO_LER(&cabeca->proximo);
+    if (cabeca == &fila->sentinela) {
+        if (proximo == NULL) {
+            return NULL;
+        }
+        // Pula a sentinela
+        fila->cabeca = proximo;
+        cabeca = proximo;
+        proximo = ATOMICO_LER(&cabeca->proximo);
+    }
+    if (proximo != NULL) {
+        fila->cabeca = proximo;
+        return cabeca;
+    }
+    if (cabeca != __atomic_load_n(&fila->cauda, __ATOMIC_SEQ_CST)) {
+        return NULL; // Um produtor trocou a cauda e ainda não encadeou o seu nó
+    }
+    // 'cabeca' é o último nó: a sentinela volta para o fim, para que ele possa sair
+    inserirNaFila(fila, &fila->sentinela);
+    proximo = ATOMICO_LER(&cabeca->proximo);
+    if (proximo != NULL) {
+        fila->cabeca = proximo;
+        return cabeca;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Indica se não há nenhum nó na fila nem nenhuma inserção em andamento
+ * * (somente a thread consumidora).
+ */
+int filaVazia(FilaMPSC* fila) {
+    return fila->cabeca == &fila->sentinela &&
+           __atomic_load_n(&fila->cauda, __ATOMIC_SEQ_CST) == &fila->sentinela;
+}
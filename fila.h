@@ -0,0 +1,24 @@
+#ifndef FILA_H
+#define FILA_H
+
+// Nó de uma fila intrusiva: fica dentro do objeto enfileirado (como primeiro campo)
+typedef struct NoFila {
+    struct NoFila* proximo;
+} NoFila;
+
+// Fila sem travas com muitos produtores e um único consumidor (MPSC).
+// Inserir custa uma troca atômica e uma escrita, de qualquer thread; só a thread
+// consumidora pode retirar. A ordem de inserção é preservada.
+typedef struct {
+    NoFila* cauda;     // Último nó inserido (disputado pelos produtores)
+    NoFila* cabeca;    // Próximo nó a retirar (só o consumidor usa)
+    NoFila sentinela;  // Nó vazio que mantém a fila sempre com pelo menos um elemento
+} FilaMPSC;
+
+// Protótipos das funções da fila
+void inicializarFila(FilaMPSC* fila);
+void inserirNaFila(FilaMPSC* fila, NoFila* no);
+NoFila* retirarDaFila(FilaMPSC* fila);
+int filaVazia(FilaMPSC* fila);
+
+#endif // FILA_H
@@ -0,0 +1,175 @@
+#include "frame_stewart.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+// Maior quantidade de movimentos impressa por executarFrameStewart
+#define LIMITE_IMPRESSAO_FS 1000
+
+// Tabelas memorizadas: menor número de movimentos e a divisão ótima (quantos discos
+// do topo vão para um pino intermediário) para cada par (pinos, discos).
+static uint64_t tabelaMinimo[ESTADO_MAX_PINOS + 1][ESTADO_MAX_DISCOS + 1];
+static unsigned char tabelaDivisao[ESTADO_MAX_PINOS + 1][ESTADO_MAX_DISCOS + 1];
+static pthread_once_t tabelasProntas = PTHREAD_ONCE_INIT;
+
+// Soma que satura em UINT64_MAX (para 3 pinos e 64 discos o valor exato é 2^64 - 1)
+static uint64_t somaSaturada(uint64_t a, uint64_t b) {
+    return (a > UINT64_MAX - b) ? UINT64_MAX : a + b;
+}
+
+// Preenche as tabelas pela recorrência T(n, k) = min_t 2 T(t, k) + T(n - t, k - 1)
+static void calcularTabelas() {
+    for (int n = 0; n <= ESTADO_MAX_DISCOS; n++) {
+        tabelaMinimo[ESTADO_MIN_PINOS][n] = estadoMascaraCompleta(n); // 2^n - 1
+        tabelaDivisao[ESTADO_MIN_PINOS][n] = (unsigned char)(n > 0 ? n - 1 : 0);
+    }
+    for (int k = ESTADO_MIN_PINOS + 1; k <= ESTADO_MAX_PINOS; k++) {
+        tabelaMinimo[k][0] = 0;
+        tabelaDivisao[k][0] = 0;
+        for (int n = 1; n <= ESTADO_MAX_DISCOS; n++) {
+            uint64_t melhor = UINT64_MAX;
+            int melhorDivisao = 0;
+            for (int t = 0; t < n; t++) {
+                uint64_t custo = somaSaturada(somaSaturada(tabelaMinimo[k][t], tabelaMinimo[k][t]),
+                                              tabelaMinimo[k - 1][n - t]);
+                if (custo < melhor) {
+                    melhor = custo;
+                    melhorDivisao = t;
+                }
+            }
+            tabelaMinimo[k][n] = melhor;
+            tabelaDivisao[k][n] = (unsigned char) melhorDivisao;
+        }
+    }
+}
+
+// Garante que as tabelas estão na memória. O cálculo leva microssegundos, então é refeito
+// a cada execução em vez de ser lido de um arquivo (seguro com várias threads do validador)
+static void prepararTabelas() {
+    pthread_once(&tabelasProntas, calcularTabelas);
+}
+
+/**
+ * @brief Retorna o número mínimo de movimentos para n discos e k pinos (Frame–Stewart).
+ * * Para 3 pinos é 2^n - 1; para k >= 4 vem da tabela memorizada. Todos os valores cabem em 64 bits.
+ * @param numDiscos O número de discos (0 a ESTADO_MAX_DISCOS).
+ * @param numPinos O número de pinos (ESTADO_MIN_PINOS a ESTADO_MAX_PINOS).
+ * @return O número mínimo de movimentos, ou 0 se os parâmetros forem inválidos.
+ */
+uint64_t movimentosOtimosMultiPinos(int numDiscos, int numPinos) {
+    if (numDiscos < 0 || numDiscos > ESTADO_MAX_DISCOS || numPinos < ESTADO_MIN_PINOS || numPinos > ESTADO_MAX_PINOS) {
+        return 0;
+    }
+    prepararTabelas();
+    return tabelaMinimo[numPinos][numDiscos];
+}
+
+// Estado compartilhado pela geração recursiva
+typedef struct {
+    CallbackMovimento callback;
+    void* contexto;
+    uint64_t limite;
+    uint64_t gerados;
+    int interrompido;     // 1 quando o callback pediu para parar
+    const int* mapaPinos; // Traduz os pinos 0, 1, 2 do solucionador de 3 pinos para os pinos reais
+} GeracaoFS;
+
+// Repassa um movimento do solucionador de 3 pinos, traduzindo os pinos
+static int repassarMovimento(int origem, int destino, void* contexto) {
+    GeracaoFS* geracao = (GeracaoFS*) contexto;
+    geracao->gerados++;
+    geracao->interrompido = geracao->callback(geracao->mapaPinos[origem], geracao->mapaPinos[destino],
+                                              geracao->contexto) != 0;
+    return geracao->interrompido;
+}
+
+// Move n discos de 'origem' para 'destino' usando apenas os pinos de 'disponiveis'.
+// Retorna 1 se a geração foi interrompida (pelo callback ou pelo limite).
+static int moverFrameStewart(GeracaoFS* geracao, int numDiscos, const int* disponiveis, int numDisponiveis,
+                             int origem, int destino) {
+    if (numDiscos == 0) {
+        return 0;
+    }
+    if (numDisponiveis == ESTADO_MIN_PINOS) {
+        // Caso base: solucionador iterativo de 3 pinos
+        int mapa[3] = {origem, -1, destino};
+        for (int i = 0; i < numDisponiveis; i++) {
+            if (disponiveis[i] != origem && disponiveis[i] != destino) mapa[1] = disponiveis[i];
+        }
+        geracao->mapaPinos = mapa;
+        resolverComCallback(numDiscos, 0, 2, geracao->limite - geracao->gerados, repassarMovimento, geracao);
+        // Interrompido se o callback parou ou se o limite foi atingido
+        return geracao->interrompido || geracao->gerados >= geracao->limite;
+    }
+
+    int t = tabelaDivisao[numDisponiveis][numDiscos];
+    int intermediario = -1;
+    int semIntermediario[ESTADO_MAX_PINOS];
+    int numSemIntermediario = 0;
+    for (int i = 0; i < numDisponiveis; i++) {
+        if (intermediario == -1 && disponiveis[i] != origem && disponiveis[i] != destino) {
+            intermediario = disponiveis[i];
+        } else {
+            semIntermediario[numSemIntermediario++] = disponiveis[i];
+        }
+    }
+
+    // 1. Os t menores vão para o intermediário usando todos os pinos
+    // 2. Os n - t maiores vão para o destino sem usar o intermediário
+    // 3. Os t menores vão do intermediário para o destino usando todos os pinos
+    return moverFrameStewart(geracao, t, disponiveis, numDisponiveis, origem, intermediario) ||
+           moverFrameStewart(geracao, numDiscos - t, semIntermediario, numSemIntermediario, origem, destino) ||
+           moverFrameStewart(geracao, t, disponiveis, numDisponiveis, intermediario, destino);
+}
+
+/**
+ * @brief Gera a sequência de Frame–Stewart para n discos e k pinos, chamando 'callback' a cada movimento.
+ * * Para k = 3 a sequência é a ótima clássica; para k >= 4 usa a divisão memorizada de cada subproblema.
+ * @param numDiscos O número de discos.
+ * @param numPinos O número de pinos.
+ * @param pinoOrigem O pino onde a torre começa.
+ * @param pinoDestino O pino para onde a torre deve ir.
+ * @param limite Número máximo de movimentos a gerar.
+ * @param callback Função chamada para cada movimento; um retorno diferente de 0 interrompe.
+ * @param contexto Ponteiro repassado ao callback.
+ * @return O número de movimentos gerados.
+ */
+uint64_t resolverFrameStewart(int numDiscos, int numPinos, int pinoOrigem, int pinoDestino, uint64_t limite,
+                              CallbackMovimento callback, void* contexto) {
+    if (movimentosOtimosMultiPinos(numDiscos, numPinos) == 0 || pinoOrigem == pinoDestino) {
+        return 0;
+    }
+    int disponiveis[ESTADO_MAX_PINOS];
+    for (int i = 0; i < numPinos; i++) {
+        disponiveis[i] = i;
+    }
+    GeracaoFS geracao = {callback, contexto, limite, 0, 0, NULL};
+    moverFrameStewart(&geracao, numDiscos, disponiveis, numPinos, pinoOrigem, pinoDestino);
+    return geracao.gerados;
+}
+
+// Imprime um movimento como duas letras (ex: "AD")
+static int imprimirMovimentoFS(int origem, int destino, void* contexto) {
+    (void) contexto;
+    printf("%c%c ", 'A' + origem, 'A' + destino);
+    return 0;
+}
+
+/**
+ * @brief Imprime o número mínimo de movimentos e, se for curta, a sequência ótima para n discos e k pinos.
+ * @return 0 em caso de sucesso, 1 se os parâmetros forem inválidos.
+ */
+int executarFrameStewart(int numDiscos, int numPinos) {
+    uint64_t minimo = movimentosOtimosMultiPinos(numDiscos, numPinos);
+    if (numDiscos < 1 || minimo == 0) {
+        fprintf(stderr, "Erro: use de 1 a %d discos e de %d a %d pinos.\n",
+                ESTADO_MAX_DISCOS, ESTADO_MIN_PINOS, ESTADO_MAX_PINOS);
+        return 1;
+    }
+    printf("%d discos, %d pinos: %llu movimentos\n", numDiscos, numPinos, (unsigned long long) minimo);
+    if (minimo <= LIMITE_IMPRESSAO_FS) {
+        resolverFrameStewart(numDiscos, numPinos, 0, numPinos - 1, minimo, imprimirMovimentoFS, NULL);
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,14 @@
+#ifndef FRAME_STEWART_H
+#define FRAME_STEWART_H
+
+#include <stdint.h> // Para uint64_t
+#include "estado.h"
+#include "solucionador.h" // Para CallbackMovimento
+
+// Protótipos do solucionador de Frame–Stewart (k pinos)
+uint64_t movimentosOtimosMultiPinos(int numDiscos, int numPinos);
+uint64_t resolverFrameStewart(int numDiscos, int numPinos, int pinoOrigem, int pinoDestino, uint64_t limite,
+                              CallbackMovimento callback, void* contexto);
+int executarFrameStewart(int numDiscos, int numPinos);
+
+#endif // FRAME_STEWART_H
@@ -0,0 +1,116 @@
+#include "tabelas_otimas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Gerador das tabelas de tabelas_otimas.h, executado pelo Makefile antes de compilar o jogo.
+// Uso: gerador_tabelas SAIDA.c [HISTORICO_V2]
+//
+// A sequência vem da definição recursiva (e não da fórmula de solucionador.c), é conferida
+// disco a disco por simulação e só então é gravada; qualquer divergência interrompe a compilação.
+
+static unsigned char movimentos[TABELA_NUM_MOVIMENTOS]; // (origem << 2) | destino
+static unsigned long numGerados = 0;
+
+// Solução recursiva clássica: n - 1 discos para o auxiliar, o maior para o destino, n - 1 por cima
+static void gerar(int numDiscos, int origem, int destino, int auxiliar) {
+    if (numDiscos == 0) {
+        return;
+    }
+    gerar(numDiscos - 1, origem, auxiliar, destino);
+    movimentos[numGerados++] = (unsigned char)((origem << 2) | destino);
+    gerar(numDiscos - 1, auxiliar, destino, origem);
+}
+
+// Aplica os 2^n - 1 primeiros movimentos a n discos no pino 0 e confere se são legais e terminam
+// a torre no pino canônico (2 para n ímpar, 1 para n par, como em movimentoCanonico)
+static int conferirPrefixo(int numDiscos) {
+    unsigned long pinos[3] = {(1ul << numDiscos) - 1, 0, 0}; // Bit i = disco i + 1; o topo é o bit mais baixo
+    unsigned long total = (1ul << numDiscos) - 1;
+    for (unsigned long i = 0; i < total; i++) {
+        int origem = movimentos[i] >> 2;
+        int destino = movimentos[i] & 3;
+        unsigned long topo = (origem <= 2) ? pinos[origem] & (0ul - pinos[origem]) : 0;
+        unsigned long topoDestino = (destino <= 2) ? pinos[destino] & (0ul - pinos[destino]) : 0;
+        if (topo == 0 || destino > 2 || (topoDestino != 0 && topoDestino < topo)) {
+            fprintf(stderr, "gerador_tabelas: movimento %lu ilegal com %d discos\n", i + 1, numDiscos);
+            return 0;
+        }
+        pinos[origem] ^= topo;
+        pinos[destino] |= topo;
+    }
+    if (pinos[(numDiscos % 2 == 1) ? 2 : 1] != (1ul << numDiscos) - 1) {
+        fprintf(stderr, "gerador_tabelas: a sequencia nao resolve %d discos\n", numDiscos);
+        return 0;
+    }
+    return 1;
+}
+
+// Confere as partidas do historico.txt da versão 2 ("nome;data;discos;movimentos") contra as tabelas:
+// nenhuma pode ter menos movimentos que a solução tabelada
+static int conferirHistoricoV2(const char* caminho) {
+    FILE* arquivo = fopen(caminho, "r");
+    if (arquivo == NULL) {
+        printf("gerador_tabelas: %s nao encontrado; conferencia do historico pulada\n", caminho);
+        return 1;
+    }
+    char linha[256];
+    int conferidas = 0, otimas = 0, ok = 1;
+    while (fgets(linha, sizeof(linha), arquivo) != NULL) {
+        char* separador = strrchr(linha, ';');
+        if (separador == NULL || separador == linha) continue;
+        *separador = '\0';
+        char* campoDiscos = strrchr(linha, ';');
+        if (campoDiscos == NULL) continue;
+        int numDiscos = atoi(campoDiscos + 1);
+        long numMovimentos = atol(separador + 1);
+        if (numDiscos < 1 || numDiscos > TABELA_MAX_DISCOS) continue;
+        long minimo = (1l << numDiscos) - 1; // Comprimento do prefixo conferido em conferirPrefixo
+        conferidas++;
+        if (numMovimentos < minimo) {
+            fprintf(stderr, "gerador_tabelas: %s tem %d discos em %ld movimentos, abaixo do minimo %ld\n",
+                    caminho, numDiscos, numMovimentos, minimo);
+            ok = 0;
+        } else if (numMovimentos == minimo) {
+            otimas++;
+        }
+    }
+    fclose(arquivo);
+    printf("gerador_tabelas: historico V2 com %d partidas conferidas, %d com a solucao da tabela\n", conferidas,
+           otimas);
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s SAIDA.c [HISTORICO_V2]\n", argv[0]);
+        return 1;
+    }
+    // Com n par a torre canônica vai do pino 0 ao 1 (ver conferirPrefixo)
+    gerar(TABELA_MAX_DISCOS, 0, (TABELA_MAX_DISCOS % 2 == 1) ? 2 : 1, (TABELA_MAX_DISCOS % 2 == 1) ? 1 : 2);
+    for (int n = 1; n <= TABELA_MAX_DISCOS; n++) {
+        if (!conferirPrefixo(n)) return 1;
+    }
+    if (argc > 2 && !conferirHistoricoV2(argv[2])) {
+        return 1;
+    }
+
+    FILE* saida = fopen(argv[1], "w");
+    if (saida == NULL) {
+        perror("gerador_tabelas: erro ao criar a saida");
+        return 1;
+    }
+    fprintf(saida, "// Gerado por gerador_tabelas.c durante a compilacao; nao edite.\n");
+    fprintf(saida, "#include \"tabelas_otimas.h\"\n\n");
+    fprintf(saida, "const unsigned char tabelaMovimentosOtimos[(TABELA_NUM_MOVIMENTOS + 1) / 2] = {\n");
+    for (unsigned long i = 0; i < numGerados; i += 2) {
+        unsigned byte = movimentos[i] | ((i + 1 < numGerados) ? (unsigned) movimentos[i + 1] << 4 : 0u);
+        fprintf(saida, "%s0x%02x,%s", (i % 32 == 0) ? "    " : "", byte, (i % 32 == 30) ? "\n" : " ");
+    }
+    fprintf(saida, "\n};\n");
+    if (fclose(saida) != 0) {
+        perror("gerador_tabelas: erro ao gravar a saida");
+        return 1;
+    }
+    return 0;
+}
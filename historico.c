@@ -1,14 +1,105 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // Para open/fstat/mmap
+#endif
+
 #include "historico.h"
+#include "indice.h" // Índices por jogador e por número de discos
+#include "pool.h"   // Pool de nós do histórico
+#include "frame_stewart.h" // Mínimo de movimentos, para converter registros antigos
+#include "instrumentacao.h" // Contadores de bytes gravados
+#include "fila.h"   // Fila sem travas das partidas à espera do gravador
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+
+#ifndef _WIN32
+#include <fcntl.h>    // Para open
+#include <sys/mman.h> // Para mmap/munmap
+#include <sys/stat.h> // Para fstat
+#include <unistd.h>   // Para close
+#endif
+
+// Arquivo onde o histórico é gravado
+#define ARQUIVO_HISTORICO "historico.dat"
+
+// Arquivo onde os movimentos das partidas são gravados
+#define ARQUIVO_MOVIMENTOS "historico_movimentos.dat"
+
+// Bytes depois do último registro válido (restos de gravações interrompidas) a partir dos quais
+// o arquivo é compactado logo após uma gravação
+#define LIMIAR_COMPACTACAO (64 * 1024)
+
+// Capacidade inicial (em bytes) do buffer de movimentos de uma partida
+#define CAPACIDADE_INICIAL_MOVIMENTOS 64
+
+// Registro das versões 1 e 2 do arquivo (e do formato sem cabeçalho): Partida sem numPinos
+typedef struct {
+    char nomeJogador[50];
+    int numDiscos;
+    int numMovimentos;
+} PartidaV2;
+
+// Registro da versão 3 do arquivo: Partida sem movimentosDesperdicados
+typedef struct {
+    char nomeJogador[50];
+    int numDiscos;
+    int numMovimentos;
+    int numPinos;
+} PartidaV3;
+
+// Registro da versão 4 do arquivo: Partida sem deslocamentoMovimentos
+typedef struct {
+    char nomeJogador[50];
+    int numDiscos;
+    int numMovimentos;
+    int numPinos;
+    int movimentosDesperdicados;
+} PartidaV4;
+
+// Nós do histórico alocados por vez no pool
+#define NOS_HISTORICO_POR_BLOCO 64
+
+// Partidas gravadas de uma vez pelo gravador
+#define LOTE_GRAVADOR 256
+
+// Partida concluída à espera do gravador, com uma cópia dos seus movimentos compactados
+typedef struct {
+    NoFila no;              // Primeiro campo: o nó da fila é o próprio registro
+    Partida partida;
+    int comMovimentos;      // 0 se a gravação dos movimentos falhou durante a partida
+    size_t bytesMovimentos;
+    uint8_t movimentos[];   // Cópia dos movimentos compactados
+} PartidaPendente;
 
 // Definição da variável global do histórico
 HistoricoGlobal *historicoGlobal = NULL;
 
+// Pool de onde saem os nós das partidas adicionadas durante a execução (usado só pelo gravador)
+static PoolObjetos poolNosHistorico;
+
+// Gravador em segundo plano: as threads que terminam partidas só inserem na fila;
+// a thread do gravador grava em lotes nos arquivos e depois na lista e nos índices.
+static FilaMPSC filaPendentes;
+static pthread_t threadGravador;
+static int gravadorAtivo = 0;
+static pthread_mutex_t travaGravador = PTHREAD_MUTEX_INITIALIZER; // Protege a memória do histórico e os campos abaixo
+static pthread_cond_t condicaoPendentes = PTHREAD_COND_INITIALIZER; // Acorda o gravador
+static pthread_cond_t condicaoGravadas = PTHREAD_COND_INITIALIZER;  // Avisa sincronizarHistorico
+static int gravadorDormindo = 0;      // Lido sem trava pelos produtores (atômico)
+static int pararGravador = 0;
+static size_t partidasEnfileiradas = 0; // Atômico
+static size_t partidasGravadas = 0;
+
+static void* executarGravador(void* argumento);
+static int anexarPartidasAoArquivo(const char* nomeArquivo, const Partida* partidas, size_t quantidade);
+static void salvarHistoricoTravado(const char* nomeArquivo);
+
 /**
  * @brief Inicializa a estrutura do histórico global de partidas.
- * * Deve ser chamada uma única vez no início do programa.
+ * * Deve ser chamada uma única vez no início do programa. O arquivo é mapeado na
+ * * memória, então o tempo de inicialização não depende do tamanho do histórico.
+ * * Também inicia a thread que grava as partidas adicionadas (ver adicionarPartida).
  */
 void inicializarHistoricoGlobal() {
     historicoGlobal = (HistoricoGlobal*) malloc(sizeof(HistoricoGlobal));
@@ -16,23 +107,44 @@ void inicializarHistoricoGlobal() {
         perror("Erro ao alocar memoria para historicoGlobal");
         exit(EXIT_FAILURE); // Aborta o programa em caso de falha crítica de memória
     }
-    historicoGlobal->inicio = NULL; // Inicializa a lista de partidas como vazia
-    carregarHistoricoDeArquivo("historico.dat"); // Tenta carregar o histórico salvo
+    memset(historicoGlobal, 0, sizeof(HistoricoGlobal)); // Lista vazia e nenhum arquivo mapeado
+    inicializarPool(&poolNosHistorico, sizeof(NoHistorico), NOS_HISTORICO_POR_BLOCO);
+    carregarHistoricoDeArquivo(ARQUIVO_HISTORICO); // Tenta carregar o histórico salvo
+
+    inicializarFila(&filaPendentes);
+    pararGravador = 0;
+    partidasEnfileiradas = 0;
+    partidasGravadas = 0;
+    // Sem a thread, adicionarPartida grava na hora
+    gravadorAtivo = pthread_create(&threadGravador, NULL, executarGravador, NULL) == 0;
+    if (!gravadorAtivo) {
+        fprintf(stderr, "Aviso: gravador do historico indisponivel; as partidas serao gravadas na hora.\n");
+    }
 }
 
 /**
  * @brief Cria e inicializa um novo objeto HistoricoMovimentos.
- * * Este objeto é usado para contabilizar os movimentos de uma única partida
+ * * Este objeto é usado para gravar os movimentos de uma única partida
  * * antes de ela ser adicionada ao histórico global.
+ * @param numPinos O número de pinos da partida.
  * @return Um ponteiro para a estrutura HistoricoMovimentos alocada, ou NULL em caso de erro.
  */
-HistoricoMovimentos* criarHistoricoMovimentos() {
+HistoricoMovimentos* criarHistoricoMovimentos(int numPinos) {
     HistoricoMovimentos* novoHistorico = (HistoricoMovimentos*) malloc(sizeof(HistoricoMovimentos));
     if (novoHistorico == NULL) {
         perror("Erro ao alocar memoria para HistoricoMovimentos");
         return NULL;
     }
     novoHistorico->numMovimentos = 0; // Inicia a contagem de movimentos em zero
+    novoHistorico->movimentosDesperdicados = 0;
+    novoHistorico->numPinos = numPinos;
+    novoHistorico->bitsPorMovimento = bitsPorMovimentoCompactado(numPinos);
+    novoHistorico->capacidade = CAPACIDADE_INICIAL_MOVIMENTOS;
+    novoHistorico->movimentos = (uint8_t*) calloc(novoHistorico->capacidade, 1);
+    if (novoHistorico->movimentos == NULL) {
+        perror("Erro ao alocar memoria para os movimentos da partida");
+        novoHistorico->capacidade = 0; // A partida continua, apenas sem gravação
+    }
     return novoHistorico;
 }
 
@@ -42,91 +154,700 @@ HistoricoMovimentos* criarHistoricoMovimentos() {
  */
 void liberarHistoricoMovimentos(HistoricoMovimentos* historico) {
     if (historico != NULL) {
+        free(historico->movimentos);
+        free(historico);
+    }
+}
+
+/**
+ * @brief Largura do código de um movimento: o menor número de bits que distingue
+ * * os k(k-1) pares (origem, destino). São 3 bits com 3 pinos e 6 bits com 8 pinos.
+ * @param numPinos O número de pinos da partida.
+ * @return O número de bits por movimento.
+ */
+int bitsPorMovimentoCompactado(int numPinos) {
+    int combinacoes = numPinos * (numPinos - 1);
+    int bits = 1;
+    while ((1 << bits) < combinacoes) {
+        bits++;
+    }
+    return bits;
+}
+
+/**
+ * @brief Bytes ocupados por uma sequência de movimentos compactados.
+ * @param numPinos O número de pinos da partida.
+ * @param numMovimentos O número de movimentos.
+ * @return O tamanho em bytes (arredondado para cima).
+ */
+size_t bytesMovimentosCompactados(int numPinos, size_t numMovimentos) {
+    return (numMovimentos * (size_t) bitsPorMovimentoCompactado(numPinos) + 7) / 8;
+}
+
+/**
+ * @brief Acrescenta um movimento à gravação da partida e atualiza o total de movimentos.
+ * * O código é origem * (k - 1) + destino, com o destino renumerado sem a origem.
+ * * O buffer dobra de tamanho quando enche, então o custo amortizado é O(1).
+ * @param historico O histórico da partida.
+ * @param origem Índice do pino de origem.
+ * @param destino Índice do pino de destino (diferente da origem).
+ * @return 1 se o movimento foi gravado, 0 se a gravação foi perdida (falta de memória) ou se os
+ * * pinos são inválidos (iguais ou fora do intervalo; nesse caso o movimento nem é contado).
+ */
+int registrarMovimento(HistoricoMovimentos* historico, int origem, int destino) {
+    // O código não representa origem == destino: gravá-lo corromperia os movimentos vizinhos
+    if (origem == destino || origem < 0 || destino < 0 || origem >= historico->numPinos ||
+        destino >= historico->numPinos) {
+        return 0;
+    }
+    size_t posicao = (size_t) historico->numMovimentos * (size_t) historico->bitsPorMovimento;
+    historico->numMovimentos++;
+    if (historico->movimentos == NULL) {
+        return 0;
+    }
+    // Um código cabe em no máximo 2 bytes a partir de posicao / 8
+    if (posicao / 8 + 2 > historico->capacidade) {
+        size_t novaCapacidade = historico->capacidade * 2;
+        uint8_t* novo = (uint8_t*) realloc(historico->movimentos, novaCapacidade);
+        if (novo == NULL) {
+            perror("Erro ao ampliar a gravacao dos movimentos");
+            free(historico->movimentos);
+            historico->movimentos = NULL; // A contagem continua; a partida fica sem gravação
+            historico->capacidade = 0;
+            return 0;
+        }
+        memset(novo + historico->capacidade, 0, novaCapacidade - historico->capacidade);
+        historico->movimentos = novo;
+        historico->capacidade = novaCapacidade;
+    }
+    unsigned codigo = (unsigned)(origem * (historico->numPinos - 1) + (destino < origem ? destino : destino - 1));
+    unsigned deslocado = codigo << (posicao % 8);
+    historico->movimentos[posicao / 8] |= (uint8_t) deslocado;
+    historico->movimentos[posicao / 8 + 1] |= (uint8_t)(deslocado >> 8);
+    return 1;
+}
+
+/**
+ * @brief Lê o movimento de número 'indice' de uma sequência compactada.
+ * @param dados Os movimentos compactados (como em HistoricoMovimentos::movimentos).
+ * @param numPinos O número de pinos da partida.
+ * @param indice A posição do movimento (0 é o primeiro).
+ * @param origem Recebe o índice do pino de origem.
+ * @param destino Recebe o índice do pino de destino.
+ */
+void decodificarMovimento(const uint8_t* dados, int numPinos, size_t indice, int* origem, int* destino) {
+    int bits = bitsPorMovimentoCompactado(numPinos);
+    size_t posicao = indice * (size_t) bits;
+    unsigned janela = dados[posicao / 8];
+    if ((posicao % 8) + (size_t) bits > 8) {
+        janela |= (unsigned) dados[posicao / 8 + 1] << 8; // Só lê o segundo byte se o código o alcança
+    }
+    unsigned codigo = (janela >> (posicao % 8)) & ((1u << bits) - 1);
+    *origem = (int)(codigo / (unsigned)(numPinos - 1));
+    int resto = (int)(codigo % (unsigned)(numPinos - 1));
+    *destino = (resto < *origem) ? resto : resto + 1;
+}
+
+// Acrescenta ao arquivo de movimentos os movimentos de um lote de partidas, abrindo-o uma só vez,
+// e guarda em cada partida a posição onde os seus movimentos começam (SEM_MOVIMENTOS em caso de erro).
+static void anexarMovimentosAoArquivo(const char* nomeArquivo, PartidaPendente** lote, size_t quantidade) {
+    size_t comMovimentos = 0;
+    for (size_t i = 0; i < quantidade; i++) {
+        comMovimentos += (size_t) lote[i]->comMovimentos;
+    }
+    if (comMovimentos == 0) {
+        return;
+    }
+    FILE* arquivo = fopen(nomeArquivo, "ab");
+    if (arquivo == NULL) {
+        perror("Erro ao abrir arquivo de movimentos");
+        return;
+    }
+    int ok = fseek(arquivo, 0, SEEK_END) == 0;
+    long posicao = ok ? ftell(arquivo) : -1;
+    if (posicao == 0) {
+        // Arquivo novo: começa com o identificador e a versão
+        uint32_t versao = HISTORICO_MOVIMENTOS_VERSAO;
+        ok = fwrite(HISTORICO_MOVIMENTOS_MAGICO, 4, 1, arquivo) == 1 && fwrite(&versao, sizeof(versao), 1, arquivo) == 1;
+        posicao = ok ? ftell(arquivo) : -1;
+    }
+    ok = ok && posicao > 0;
+    size_t gravados = 0;
+    for (size_t i = 0; ok && i < quantidade; i++) {
+        if (!lote[i]->comMovimentos) continue;
+        size_t tamanho = lote[i]->bytesMovimentos;
+        ok = tamanho == 0 || fwrite(lote[i]->movimentos, 1, tamanho, arquivo) == tamanho;
+        lote[i]->partida.deslocamentoMovimentos = (uint64_t) posicao;
+        posicao += (long) tamanho;
+        gravados += tamanho;
+    }
+    if (fclose(arquivo) != 0 || !ok) {
+        perror("Erro ao gravar movimentos da partida");
+        // Com a escrita em buffer não dá para saber quais chegaram ao disco
+        for (size_t i = 0; i < quantidade; i++) {
+            lote[i]->partida.deslocamentoMovimentos = SEM_MOVIMENTOS;
+        }
+        return;
+    }
+    INSTR_SOMAR(CONTADOR_BYTES_HISTORICO, gravados);
+}
+
+/**
+ * @brief Lê de volta os movimentos gravados de uma partida.
+ * @param partida A partida (deslocamentoMovimentos diferente de SEM_MOVIMENTOS).
+ * @return Um HistoricoMovimentos com os movimentos (liberar com liberarHistoricoMovimentos),
+ *         ou NULL se a partida não tem gravação ou o arquivo não pôde ser lido.
+ */
+HistoricoMovimentos* lerMovimentosDaPartida(const Partida* partida) {
+    if (partida->deslocamentoMovimentos == SEM_MOVIMENTOS || partida->numMovimentos < 0) {
+        return NULL;
+    }
+    FILE* arquivo = fopen(ARQUIVO_MOVIMENTOS, "rb");
+    if (arquivo == NULL) {
+        perror("Erro ao abrir arquivo de movimentos");
+        return NULL;
+    }
+    char magico[4];
+    uint32_t versao = 0;
+    if (fread(magico, sizeof(magico), 1, arquivo) != 1 || fread(&versao, sizeof(versao), 1, arquivo) != 1 ||
+        memcmp(magico, HISTORICO_MOVIMENTOS_MAGICO, sizeof(magico)) != 0 || versao != HISTORICO_MOVIMENTOS_VERSAO) {
+        fprintf(stderr, "Erro: %s nao esta no formato de movimentos esperado.\n", ARQUIVO_MOVIMENTOS);
+        fclose(arquivo);
+        return NULL;
+    }
+
+    HistoricoMovimentos* historico = (HistoricoMovimentos*) malloc(sizeof(HistoricoMovimentos));
+    size_t tamanho = bytesMovimentosCompactados(partida->numPinos, (size_t) partida->numMovimentos);
+    uint8_t* movimentos = (uint8_t*) calloc(tamanho > 0 ? tamanho : 1, 1);
+    if (historico == NULL || movimentos == NULL) {
+        perror("Erro ao alocar memoria para os movimentos da partida");
+        free(historico);
+        free(movimentos);
+        fclose(arquivo);
+        return NULL;
+    }
+    if (fseek(arquivo, (long) partida->deslocamentoMovimentos, SEEK_SET) != 0 ||
+        fread(movimentos, 1, tamanho, arquivo) != tamanho) {
+        fprintf(stderr, "Erro: movimentos da partida de %s incompletos em %s.\n",
+                partida->nomeJogador, ARQUIVO_MOVIMENTOS);
         free(historico);
+        free(movimentos);
+        fclose(arquivo);
+        return NULL;
+    }
+    fclose(arquivo);
+
+    historico->numMovimentos = partida->numMovimentos;
+    historico->movimentosDesperdicados = partida->movimentosDesperdicados;
+    historico->numPinos = partida->numPinos;
+    historico->bitsPorMovimento = bitsPorMovimentoCompactado(partida->numPinos);
+    historico->movimentos = movimentos;
+    historico->capacidade = tamanho;
+    return historico;
+}
+
+/**
+ * @brief Lê o arquivo de movimentos inteiro para a memória, para validar muitas partidas de uma vez.
+ * * Os deslocamentos das partidas valem diretamente como índices no bloco retornado.
+ * * O bloco tem 8 bytes zerados além do fim, para que a leitura de um código possa
+ * * sempre usar 2 bytes sem testar o limite.
+ * @param tamanho Recebe o tamanho do arquivo (sem a folga).
+ * @return O bloco (liberar com free), ou NULL se o arquivo não existe ou não pôde ser lido.
+ */
+uint8_t* lerArquivoDeMovimentos(size_t* tamanho) {
+    FILE* arquivo = fopen(ARQUIVO_MOVIMENTOS, "rb");
+    if (arquivo == NULL) {
+        return NULL;
+    }
+    fseek(arquivo, 0, SEEK_END);
+    long tamanhoArquivo = ftell(arquivo);
+    rewind(arquivo);
+    uint8_t* bloco = (tamanhoArquivo >= 0) ? (uint8_t*) calloc((size_t) tamanhoArquivo + 8, 1) : NULL;
+    if (bloco == NULL || fread(bloco, 1, (size_t) tamanhoArquivo, arquivo) != (size_t) tamanhoArquivo) {
+        perror("Erro ao ler arquivo de movimentos");
+        free(bloco);
+        fclose(arquivo);
+        return NULL;
+    }
+    fclose(arquivo);
+    if (tamanhoArquivo < 8 || memcmp(bloco, HISTORICO_MOVIMENTOS_MAGICO, 4) != 0) {
+        fprintf(stderr, "Erro: %s nao esta no formato de movimentos esperado.\n", ARQUIVO_MOVIMENTOS);
+        free(bloco);
+        return NULL;
+    }
+    *tamanho = (size_t) tamanhoArquivo;
+    return bloco;
+}
+
+// Coloca uma partida já gravada na lista em memória e nos índices (com travaGravador)
+static void inserirPartidaNaMemoria(const Partida* partida) {
+    NoHistorico* novoNo = (NoHistorico*) obterDoPool(&poolNosHistorico);
+    if (novoNo == NULL) {
+        perror("Erro ao alocar memoria para NoHistorico");
+        return;
+    }
+    novoNo->partida = *partida;
+    novoNo->proximo = historicoGlobal->inicio; // Adiciona no início da lista (mais recente primeiro)
+    historicoGlobal->inicio = novoNo;
+    indexarPartida(&novoNo->partida); // Atualiza os índices de consulta sem varrer o histórico
+}
+
+// Grava um lote de partidas: movimentos e registros com uma abertura de cada arquivo,
+// e só então a lista em memória. 'partidas' é a área onde os registros são reunidos
+// (espaço para 'quantidade' partidas). Libera as partidas do lote.
+static void gravarLote(PartidaPendente** lote, Partida* partidas, size_t quantidade) {
+    anexarMovimentosAoArquivo(ARQUIVO_MOVIMENTOS, lote, quantidade);
+    for (size_t i = 0; i < quantidade; i++) {
+        partidas[i] = lote[i]->partida;
+    }
+    // Acrescenta só os novos registros ao fim do arquivo: o custo não depende do tamanho do histórico
+    anexarPartidasAoArquivo(ARQUIVO_HISTORICO, partidas, quantidade);
+
+    pthread_mutex_lock(&travaGravador);
+    for (size_t i = 0; i < quantidade; i++) {
+        inserirPartidaNaMemoria(&partidas[i]);
+    }
+    partidasGravadas += quantidade;
+    pthread_cond_broadcast(&condicaoGravadas);
+    pthread_mutex_unlock(&travaGravador);
+    for (size_t i = 0; i < quantidade; i++) {
+        free(lote[i]);
+    }
+}
+
+// Corpo da thread do gravador: grava as partidas pendentes em lotes e dorme quando a fila esvazia
+static void* executarGravador(void* argumento) {
+    (void) argumento;
+    PartidaPendente* lote[LOTE_GRAVADOR];
+    Partida partidas[LOTE_GRAVADOR];
+    while (1) {
+        size_t quantidade = 0;
+        NoFila* no;
+        while (quantidade < LOTE_GRAVADOR && (no = retirarDaFila(&filaPendentes)) != NULL) {
+            lote[quantidade++] = (PartidaPendente*) no;
+        }
+        if (quantidade > 0) {
+            gravarLote(lote, partidas, quantidade);
+            continue;
+        }
+        pthread_mutex_lock(&travaGravador);
+        // Anuncia que vai dormir antes de conferir a fila: um produtor que inserir depois
+        // disso vê o aviso e acorda o gravador (as duas operações são sequencialmente consistentes)
+        __atomic_store_n(&gravadorDormindo, 1, __ATOMIC_SEQ_CST);
+        int vazia = filaVazia(&filaPendentes);
+        if (vazia && pararGravador) {
+            pthread_mutex_unlock(&travaGravador);
+            break;
+        }
+        if (vazia) {
+            pthread_cond_wait(&condicaoPendentes, &travaGravador);
+        }
+        __atomic_store_n(&gravadorDormindo, 0, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&travaGravador);
     }
+    return NULL;
 }
 
 /**
  * @brief Adiciona uma partida concluída ao histórico global.
- * * Cria um novo nó na lista encadeada e insere a partida.
- * * @param nomeJogador O nome do jogador da partida.
+ * * A partida e uma cópia dos seus movimentos entram em uma fila sem travas, e a thread
+ * * do gravador faz o resto em segundo plano (arquivos, lista e índices). Quem chama
+ * * nunca espera por disco e pode liberar historicoPartida logo em seguida.
+ * * Pode ser chamada por várias threads ao mesmo tempo.
+ * @param nomeJogador O nome do jogador da partida.
  * @param numDiscos O número de discos da partida.
- * @param historicoPartida O objeto HistoricoMovimentos com o total de movimentos da partida.
+ * @param numPinos O número de pinos da partida.
+ * @param historicoPartida O objeto HistoricoMovimentos com os movimentos da partida.
  */
-void adicionarPartida(const char* nomeJogador, int numDiscos, HistoricoMovimentos* historicoPartida) {
+void adicionarPartida(const char* nomeJogador, int numDiscos, int numPinos, HistoricoMovimentos* historicoPartida) {
     if (historicoGlobal == NULL) {
         fprintf(stderr, "Erro: Historico global nao inicializado.\n");
         return;
     }
 
-    NoHistorico* novoNo = (NoHistorico*) malloc(sizeof(NoHistorico));
-    if (novoNo == NULL) {
-        perror("Erro ao alocar memoria para NoHistorico");
+    int comMovimentos = historicoPartida->movimentos != NULL;
+    size_t bytes = comMovimentos ? bytesMovimentosCompactados(historicoPartida->numPinos,
+                                                              (size_t) historicoPartida->numMovimentos) : 0;
+    PartidaPendente* pendente = (PartidaPendente*) malloc(sizeof(PartidaPendente) + bytes);
+    if (pendente == NULL) {
+        perror("Erro ao alocar memoria para a partida pendente");
         return;
     }
+    memset(&pendente->partida, 0, sizeof(Partida));
+    strncpy(pendente->partida.nomeJogador, nomeJogador, sizeof(pendente->partida.nomeJogador) - 1);
+    pendente->partida.numDiscos = numDiscos;
+    pendente->partida.numPinos = numPinos;
+    pendente->partida.numMovimentos = historicoPartida->numMovimentos; // Pega o total de movimentos da partida
+    pendente->partida.movimentosDesperdicados = historicoPartida->movimentosDesperdicados;
+    // Definido pelo gravador, que grava os movimentos antes da partida
+    pendente->partida.deslocamentoMovimentos = SEM_MOVIMENTOS;
+    pendente->comMovimentos = comMovimentos;
+    pendente->bytesMovimentos = bytes;
+    if (bytes > 0) {
+        memcpy(pendente->movimentos, historicoPartida->movimentos, bytes);
+    }
 
-    strncpy(novoNo->partida.nomeJogador, nomeJogador, sizeof(novoNo->partida.nomeJogador) - 1);
-    novoNo->partida.nomeJogador[sizeof(novoNo->partida.nomeJogador) - 1] = '\0'; // Garante null-termination
-    novoNo->partida.numDiscos = numDiscos;
-    novoNo->partida.numMovimentos = historicoPartida->numMovimentos; // Pega o total de movimentos da partida
+    if (!gravadorAtivo) {
+        Partida registro;
+        gravarLote(&pendente, &registro, 1);
+        return;
+    }
+    __atomic_fetch_add(&partidasEnfileiradas, 1, __ATOMIC_SEQ_CST);
+    inserirNaFila(&filaPendentes, &pendente->no);
+    if (__atomic_load_n(&gravadorDormindo, __ATOMIC_SEQ_CST)) {
+        // A trava só é disputada com o gravador ocioso, nunca durante a gravação em disco
+        pthread_mutex_lock(&travaGravador);
+        pthread_cond_signal(&condicaoPendentes);
+        pthread_mutex_unlock(&travaGravador);
+    }
+}
 
-    novoNo->proximo = historicoGlobal->inicio; // Adiciona no início da lista (mais recente primeiro)
-    historicoGlobal->inicio = novoNo;
+/**
+ * @brief Espera o gravador terminar as partidas adicionadas até agora.
+ * * As leituras do histórico (exibição, consultas, percursos) chamam esta função, por
+ * * travarHistorico, e então veem todas as partidas já adicionadas por esta thread.
+ */
+void sincronizarHistorico() {
+    if (!gravadorAtivo) {
+        return;
+    }
+    size_t alvo = __atomic_load_n(&partidasEnfileiradas, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&travaGravador);
+    while (partidasGravadas < alvo) {
+        pthread_cond_wait(&condicaoGravadas, &travaGravador);
+    }
+    pthread_mutex_unlock(&travaGravador);
+}
+
+/**
+ * @brief Espera o gravador (como sincronizarHistorico) e trava o histórico e os índices.
+ * * Enquanto a trava estiver com quem leu, o gravador não liga nós à lista nem altera os
+ * * índices; os produtores continuam livres, pois só usam a fila. Toda leitura da lista
+ * * ou dos índices acontece entre travarHistorico e destravarHistorico. Não é reentrante:
+ * * entre as duas chamadas, use só as funções "Travado" e as que não leem o histórico.
+ */
+void travarHistorico() {
+    sincronizarHistorico();
+    pthread_mutex_lock(&travaGravador);
+}
+
+/**
+ * @brief Libera a trava obtida por travarHistorico.
+ */
+void destravarHistorico() {
+    pthread_mutex_unlock(&travaGravador);
+}
+
+/**
+ * @brief Retorna o número total de partidas no histórico (do arquivo e da execução atual).
+ */
+size_t totalPartidasHistorico() {
+    if (historicoGlobal == NULL) {
+        return 0;
+    }
+    travarHistorico();
+    size_t total = totalPartidasHistoricoTravado();
+    destravarHistorico();
+    return total;
+}
+
+/**
+ * @brief Como totalPartidasHistorico, para quem já chamou travarHistorico.
+ */
+size_t totalPartidasHistoricoTravado() {
+    size_t total = historicoGlobal->numRegistros;
+    for (NoHistorico* atual = historicoGlobal->inicio; atual != NULL; atual = atual->proximo) {
+        total++;
+    }
+    return total;
+}
+
+/**
+ * @brief Percorre todas as partidas, da mais recente para a mais antiga.
+ * * Primeiro as adicionadas nesta execução, depois as do arquivo, lidas direto do mapeamento.
+ * * O histórico fica travado durante o percurso: o visitante não deve chamar funções
+ * * que travam o histórico (consultas, exibição, adicionarPartida sem gravador).
+ * @param visitante Função chamada para cada partida; um retorno diferente de 0 interrompe.
+ * @param contexto Ponteiro repassado ao visitante.
+ */
+void percorrerHistorico(VisitantePartida visitante, void* contexto) {
+    if (historicoGlobal == NULL) {
+        return;
+    }
+    travarHistorico();
+    percorrerHistoricoTravado(visitante, contexto);
+    destravarHistorico();
+}
+
+/**
+ * @brief Como percorrerHistorico, para quem já chamou travarHistorico.
+ */
+void percorrerHistoricoTravado(VisitantePartida visitante, void* contexto) {
+    for (NoHistorico* atual = historicoGlobal->inicio; atual != NULL; atual = atual->proximo) {
+        if (visitante(&atual->partida, contexto) != 0) {
+            return;
+        }
+    }
+    for (size_t i = historicoGlobal->numRegistros; i > 0; i--) {
+        if (visitante(&historicoGlobal->registros[i - 1], contexto) != 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Copia a partida de uma posição do histórico, na numeração de exibirHistorico.
+ * @param posicao A posição da partida (1 é a mais recente).
+ * @param partida Recebe a cópia da partida.
+ * @return 1 se a posição existe, 0 caso contrário.
+ */
+int obterPartidaPorPosicao(size_t posicao, Partida* partida) {
+    if (historicoGlobal == NULL || posicao == 0) {
+        return 0;
+    }
+    travarHistorico();
+    int encontrada = 0;
+    for (NoHistorico* atual = historicoGlobal->inicio; atual != NULL; atual = atual->proximo) {
+        if (--posicao == 0) {
+            *partida = atual->partida;
+            encontrada = 1;
+            break;
+        }
+    }
+    if (!encontrada && posicao <= historicoGlobal->numRegistros) {
+        *partida = historicoGlobal->registros[historicoGlobal->numRegistros - posicao];
+        encontrada = 1;
+    }
+    destravarHistorico();
+    return encontrada;
+}
 
-    salvarHistoricoEmArquivo("historico.dat"); // Salva o histórico após adicionar uma nova partida
+// Imprime uma linha do histórico (usada por exibirHistorico)
+static int imprimirPartida(const Partida* partida, void* contexto) {
+    int* contador = (int*) contexto;
+    printf("%d. Jogador: %s, Discos: %d, Pinos: %d, Movimentos: %d, Desperdicados: %d, Eficiencia: %.1f%%\n",
+           (*contador)++, partida->nomeJogador, partida->numDiscos, partida->numPinos, partida->numMovimentos,
+           partida->movimentosDesperdicados, 100.0 * eficienciaPartida(partida));
+    return 0;
 }
 
 /**
  * @brief Exibe todas as partidas registradas no histórico.
  */
 void exibirHistorico() {
-    if (historicoGlobal == NULL || historicoGlobal->inicio == NULL) {
+    if (historicoGlobal == NULL) {
+        printf("\nNenhum historico de partidas disponivel.\n");
+        return;
+    }
+    travarHistorico(); // A contagem e a listagem veem o mesmo histórico
+    if (totalPartidasHistoricoTravado() == 0) {
+        destravarHistorico();
         printf("\nNenhum historico de partidas disponivel.\n");
         return;
     }
 
     printf("\n--- Historico de Partidas ---\n");
     printf("-----------------------------\n");
-    NoHistorico* atual = historicoGlobal->inicio;
     int contador = 1;
-    while (atual != NULL) {
-        printf("%d. Jogador: %s, Discos: %d, Movimentos: %d\n",
-               contador++, atual->partida.nomeJogador, atual->partida.numDiscos, atual->partida.numMovimentos);
-        atual = atual->proximo;
-    }
+    percorrerHistoricoTravado(imprimirPartida, &contador);
+    destravarHistorico();
     printf("-----------------------------\n");
 }
 
+// Preenche o cabeçalho da versão atual do formato
+static void montarCabecalho(CabecalhoHistorico* cabecalho, uint64_t numRegistros) {
+    memset(cabecalho, 0, sizeof(CabecalhoHistorico));
+    memcpy(cabecalho->magico, HISTORICO_MAGICO, sizeof(cabecalho->magico));
+    cabecalho->versao = HISTORICO_VERSAO;
+    cabecalho->tamanhoRegistro = (uint32_t) sizeof(Partida);
+    cabecalho->numRegistros = numRegistros;
+}
+
 /**
- * @brief Salva o histórico de partidas em um arquivo binário.
+ * @brief Reescreve o arquivo de histórico inteiro a partir da memória (compactação).
+ * * Grava o cabeçalho e as partidas da mais antiga para a mais recente em um arquivo
+ * * temporário e só então substitui o original, para que uma falha no meio não perca dados.
+ * * Usada para converter arquivos de formatos anteriores; a gravação normal de uma
+ * * partida usa anexarPartidaAoArquivo.
  * @param nomeArquivo O nome do arquivo onde o histórico será salvo.
  */
 void salvarHistoricoEmArquivo(const char* nomeArquivo) {
     if (historicoGlobal == NULL) {
         return; // Nada para salvar se o histórico não foi inicializado
     }
+    travarHistorico();
+    salvarHistoricoTravado(nomeArquivo);
+    destravarHistorico();
+}
 
-    FILE* arquivo = fopen(nomeArquivo, "wb"); // Abre o arquivo em modo de escrita binária
+// Corpo de salvarHistoricoEmArquivo, com o histórico já travado
+static void salvarHistoricoTravado(const char* nomeArquivo) {
+    // A lista está da mais recente para a mais antiga: junta os nós para gravar ao contrário
+    size_t totalLista = 0;
+    for (NoHistorico* atual = historicoGlobal->inicio; atual != NULL; atual = atual->proximo) {
+        totalLista++;
+    }
+    NoHistorico** ordem = (NoHistorico**) malloc((totalLista > 0 ? totalLista : 1) * sizeof(NoHistorico*));
+    if (ordem == NULL) {
+        perror("Erro ao alocar memoria para compactar historico");
+        return;
+    }
+    size_t indice = totalLista;
+    for (NoHistorico* atual = historicoGlobal->inicio; atual != NULL; atual = atual->proximo) {
+        ordem[--indice] = atual;
+    }
+
+    char nomeTemporario[FILENAME_MAX];
+    snprintf(nomeTemporario, sizeof(nomeTemporario), "%s.tmp", nomeArquivo);
+    FILE* arquivo = fopen(nomeTemporario, "wb"); // Abre o arquivo em modo de escrita binária
     if (arquivo == NULL) {
         perror("Erro ao abrir arquivo para salvar historico");
+        free(ordem);
         return;
     }
 
-    NoHistorico* atual = historicoGlobal->inicio;
-    while (atual != NULL) {
+    CabecalhoHistorico cabecalho;
+    montarCabecalho(&cabecalho, (uint64_t)(historicoGlobal->numRegistros + totalLista));
+    int ok = fwrite(&cabecalho, sizeof(CabecalhoHistorico), 1, arquivo) == 1;
+    // As partidas do arquivo já estão contíguas: uma única escrita
+    if (ok && historicoGlobal->numRegistros > 0) {
+        ok = fwrite(historicoGlobal->registros, sizeof(Partida), historicoGlobal->numRegistros, arquivo)
+             == historicoGlobal->numRegistros;
+    }
+    for (size_t i = 0; ok && i < totalLista; i++) {
         // Escreve a estrutura Partida diretamente no arquivo
-        fwrite(&(atual->partida), sizeof(Partida), 1, arquivo);
-        atual = atual->proximo;
+        ok = fwrite(&(ordem[i]->partida), sizeof(Partida), 1, arquivo) == 1;
     }
+    free(ordem);
 
-    fclose(arquivo);
+    if (fclose(arquivo) != 0 || !ok) {
+        perror("Erro ao gravar historico");
+        remove(nomeTemporario);
+        return;
+    }
+    INSTR_SOMAR(CONTADOR_GRAVACOES_HISTORICO, 1);
+    INSTR_SOMAR(CONTADOR_BYTES_HISTORICO, sizeof(CabecalhoHistorico) + cabecalho.numRegistros * sizeof(Partida));
+    remove(nomeArquivo); // No Windows, rename falha se o destino existir
+    if (rename(nomeTemporario, nomeArquivo) != 0) {
+        perror("Erro ao substituir arquivo de historico");
+    }
 }
 
 /**
- * @brief Carrega o histórico de partidas de um arquivo binário.
- * @param nomeArquivo O nome do arquivo de onde o histórico será carregado.
+ * @brief Acrescenta uma partida ao arquivo de histórico.
+ * * Grava o registro logo após o último registro válido e só então atualiza o contador
+ * * do cabeçalho; se a gravação for interrompida, o registro incompleto fica fora da
+ * * contagem e é sobrescrito na próxima vez; restos maiores que LIMIAR_COMPACTACAO são
+ * * cortados logo após a gravação. Cria o arquivo se ele ainda não existir.
+ * @param nomeArquivo O nome do arquivo de histórico.
+ * @param partida A partida a ser gravada.
+ * @return 1 em caso de sucesso, 0 em caso de erro.
  */
-void carregarHistoricoDeArquivo(const char* nomeArquivo) {
+int anexarPartidaAoArquivo(const char* nomeArquivo, const Partida* partida) {
+    return anexarPartidasAoArquivo(nomeArquivo, partida, 1);
+}
+
+// Compactação periódica do log: como as partidas só são acrescentadas, o único espaço
+// recuperável é o que sobra depois do último registro válido (gravações interrompidas).
+// Esse resto é sobrescrito pelas próximas gravações; quando passa de LIMIAR_COMPACTACAO,
+// o arquivo é cortado no fim dos registros válidos. Um mapeamento feito ao carregar nunca
+// vai além desse ponto, então continua válido.
+static void compactarSeNecessario(FILE* arquivo, long fimValido) {
+    if (fflush(arquivo) != 0 || fseek(arquivo, 0, SEEK_END) != 0) {
+        return;
+    }
+    long tamanho = ftell(arquivo);
+    if (tamanho < 0 || tamanho - fimValido < LIMIAR_COMPACTACAO) {
+        return;
+    }
+#ifndef _WIN32
+    if (ftruncate(fileno(arquivo), (off_t) fimValido) != 0) {
+        perror("Erro ao compactar historico"); // Não é grave: o resto continua fora da contagem
+    }
+#endif
+    // Sem ftruncate (Windows), o resto continua sendo sobrescrito pelas próximas gravações
+}
+
+// Como anexarPartidaAoArquivo, para um lote: uma escrita e uma atualização do cabeçalho
+static int anexarPartidasAoArquivo(const char* nomeArquivo, const Partida* partidas, size_t quantidade) {
+    FILE* arquivo = fopen(nomeArquivo, "r+b"); // Leitura e escrita, sem truncar
+    CabecalhoHistorico cabecalho;
+    if (arquivo == NULL || fread(&cabecalho, sizeof(CabecalhoHistorico), 1, arquivo) != 1) {
+        if (arquivo != NULL) fclose(arquivo);
+        arquivo = fopen(nomeArquivo, "w+b"); // Arquivo novo (ou vazio): começa com um cabeçalho
+        if (arquivo == NULL) {
+            perror("Erro ao abrir arquivo para gravar partida");
+            return 0;
+        }
+        montarCabecalho(&cabecalho, 0);
+    } else if (memcmp(cabecalho.magico, HISTORICO_MAGICO, sizeof(cabecalho.magico)) != 0 ||
+               cabecalho.versao != HISTORICO_VERSAO || cabecalho.tamanhoRegistro != sizeof(Partida)) {
+        fprintf(stderr, "Erro: %s nao esta no formato atual de historico.\n", nomeArquivo);
+        fclose(arquivo);
+        return 0;
+    }
+
+    long posicao = (long)(sizeof(CabecalhoHistorico) + cabecalho.numRegistros * sizeof(Partida));
+    int ok = fseek(arquivo, posicao, SEEK_SET) == 0 &&
+             fwrite(partidas, sizeof(Partida), quantidade, arquivo) == quantidade;
+    if (ok) {
+        cabecalho.numRegistros += quantidade;
+        ok = fflush(arquivo) == 0 && fseek(arquivo, 0, SEEK_SET) == 0 &&
+             fwrite(&cabecalho, sizeof(CabecalhoHistorico), 1, arquivo) == 1;
+    }
+    if (ok) {
+        compactarSeNecessario(arquivo, posicao + (long)(quantidade * sizeof(Partida)));
+    }
+
+    if (fclose(arquivo) != 0 || !ok) {
+        perror("Erro ao gravar partida no historico");
+        return 0;
+    }
+    INSTR_SOMAR(CONTADOR_GRAVACOES_HISTORICO, 1);
+    INSTR_SOMAR(CONTADOR_BYTES_HISTORICO, quantidade * sizeof(Partida) + sizeof(CabecalhoHistorico));
+    return 1;
+}
+
+// Desfaz o mapeamento (ou libera o bloco lido) das partidas do arquivo
+static void liberarRegistrosDoArquivo() {
+    if (historicoGlobal->mapeamento != NULL) {
+#ifndef _WIN32
+        if (historicoGlobal->tamanhoMapeamento > 0) {
+            munmap(historicoGlobal->mapeamento, historicoGlobal->tamanhoMapeamento);
+        } else
+#endif
+        {
+            free(historicoGlobal->mapeamento);
+        }
+    }
+    historicoGlobal->mapeamento = NULL;
+    historicoGlobal->tamanhoMapeamento = 0;
+    historicoGlobal->registros = NULL;
+    historicoGlobal->numRegistros = 0;
+}
+
+// Lê o arquivo inteiro em um único bloco alocado (usado sem mmap ou para converter formatos antigos)
+static void* lerArquivoInteiro(const char* nomeArquivo, size_t* tamanho) {
+    FILE* arquivo = fopen(nomeArquivo, "rb");
+    if (arquivo == NULL) {
+        return NULL;
+    }
+    fseek(arquivo, 0, SEEK_END);
+    long tamanhoArquivo = ftell(arquivo);
+    rewind(arquivo);
+    void* bloco = (tamanhoArquivo > 0) ? malloc((size_t) tamanhoArquivo) : NULL;
+    if (bloco == NULL || fread(bloco, 1, (size_t) tamanhoArquivo, arquivo) != (size_t) tamanhoArquivo) {
+        free(bloco);
+        fclose(arquivo);
+        return NULL;
+    }
+    fclose(arquivo);
+    *tamanho = (size_t) tamanhoArquivo;
+    return bloco;
+}
+
+// Mapeia (ou lê) o arquivo e aponta historicoGlobal->registros para as partidas gravadas
+static void carregarRegistros(const char* nomeArquivo) {
     if (historicoGlobal == NULL) {
         fprintf(stderr, "Erro: Historico global nao inicializado antes de carregar.\n");
         return;
@@ -137,35 +858,122 @@ void carregarHistoricoDeArquivo(const char* nomeArquivo) {
     while (atual != NULL) {
         NoHistorico* temp = atual;
         atual = atual->proximo;
-        free(temp);
+        devolverAoPool(&poolNosHistorico, temp);
     }
     historicoGlobal->inicio = NULL; // Garante que a lista está vazia
+    liberarRegistrosDoArquivo();
 
-    FILE* arquivo = fopen(nomeArquivo, "rb"); // Abre o arquivo em modo de leitura binária
-    if (arquivo == NULL) {
+    void* dados = NULL;
+    size_t tamanho = 0;
+    size_t tamanhoMapeamento = 0;
+#ifndef _WIN32
+    int descritor = open(nomeArquivo, O_RDONLY);
+    if (descritor < 0) {
         // Se o arquivo não existe, não é um erro grave, apenas significa que não há histórico salvo ainda.
-        // perror("Erro ao abrir arquivo para carregar historico"); // Descomente para depurar
+        return;
+    }
+    struct stat informacoes;
+    if (fstat(descritor, &informacoes) == 0 && informacoes.st_size > 0) {
+        tamanho = (size_t) informacoes.st_size;
+        dados = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_PRIVATE, descritor, 0);
+        if (dados == MAP_FAILED) {
+            dados = NULL;
+        } else {
+            tamanhoMapeamento = tamanho;
+        }
+    }
+    close(descritor); // O mapeamento continua válido depois de fechar o descritor
+#endif
+    if (dados == NULL) {
+        dados = lerArquivoInteiro(nomeArquivo, &tamanho);
+        if (dados == NULL) {
+            return; // Arquivo inexistente ou vazio
+        }
+    }
+    historicoGlobal->mapeamento = dados;
+    historicoGlobal->tamanhoMapeamento = tamanhoMapeamento;
+
+    const CabecalhoHistorico* cabecalho = (const CabecalhoHistorico*) dados;
+    int temCabecalho = tamanho >= TAMANHO_CABECALHO_V1 &&
+                       memcmp(cabecalho->magico, HISTORICO_MAGICO, sizeof(cabecalho->magico)) == 0;
+    if (temCabecalho && cabecalho->versao == HISTORICO_VERSAO && tamanho >= sizeof(CabecalhoHistorico) &&
+        cabecalho->tamanhoRegistro == sizeof(Partida)) {
+        // Formato atual: visão direta do vetor de registros, limitada ao que existe no arquivo
+        size_t noArquivo = (tamanho - sizeof(CabecalhoHistorico)) / sizeof(Partida);
+        historicoGlobal->registros = (const Partida*)((const char*) dados + sizeof(CabecalhoHistorico));
+        historicoGlobal->numRegistros = (cabecalho->numRegistros < noArquivo) ? (size_t) cabecalho->numRegistros
+                                                                              : noArquivo;
+        return;
+    }
+    // Versões anteriores: tamanho do registro de cada uma (0 = não suportada)
+    uint32_t versao = temCabecalho ? cabecalho->versao : 1;
+    size_t tamanhoAntigo = (versao == 1 || versao == 2) ? sizeof(PartidaV2) : (versao == 3) ? sizeof(PartidaV3)
+                         : (versao == 4) ? sizeof(PartidaV4) : 0;
+    if (tamanhoAntigo == 0 || (temCabecalho && cabecalho->tamanhoRegistro != tamanhoAntigo)) {
+        // Não sobrescreve um arquivo que esta versão do programa não entende
+        fprintf(stderr, "Erro: %s usa um formato de historico nao suportado (versao %u).\n",
+                nomeArquivo, (unsigned) versao);
+        liberarRegistrosDoArquivo();
         return;
     }
 
-    Partida tempPartida;
-    // Lê as estruturas Partida do arquivo uma por uma
-    while (fread(&tempPartida, sizeof(Partida), 1, arquivo) == 1) {
-        // Adiciona a partida lida ao histórico global (no início da lista)
-        NoHistorico* novoNo = (NoHistorico*) malloc(sizeof(NoHistorico));
-        if (novoNo == NULL) {
-            perror("Erro ao alocar memoria ao carregar historico");
-            // Se a alocação falhar durante o carregamento, pare e limpe o que foi carregado.
-            liberarHistoricoGlobal(); 
-            fclose(arquivo);
-            return;
+    // Versões 1 a 4 ou formato antigo (sem cabeçalho): os registros são convertidos de uma vez
+    // para um único bloco no formato atual. Antes da versão 3 todas as partidas usavam 3 pinos;
+    // antes da versão 4, como toda partida começava da posição inicial, o desperdício é o total
+    // menos o mínimo. Antes da versão 5 os movimentos não eram gravados.
+    size_t inicioRegistros = !temCabecalho ? 0 : (versao == 1) ? TAMANHO_CABECALHO_V1 : sizeof(CabecalhoHistorico);
+    size_t numRegistros = (tamanho >= inicioRegistros) ? (tamanho - inicioRegistros) / tamanhoAntigo : 0;
+    if (temCabecalho && versao >= 2 && cabecalho->numRegistros < numRegistros) {
+        numRegistros = (size_t) cabecalho->numRegistros;
+    }
+    Partida* registros = (Partida*) malloc((numRegistros > 0 ? numRegistros : 1) * sizeof(Partida));
+    if (registros == NULL) {
+        perror("Erro ao alocar memoria para converter historico");
+        liberarRegistrosDoArquivo();
+        return;
+    }
+    const char* antigas = (const char*) dados + inicioRegistros;
+    for (size_t i = 0; i < numRegistros; i++) {
+        // O formato sem cabeçalho foi gravado da mais recente para a mais antiga: inverte
+        const char* antiga = antigas + (temCabecalho ? i : numRegistros - 1 - i) * tamanhoAntigo;
+        const PartidaV2* v2 = (const PartidaV2*) antiga; // Campos comuns a todas as versões
+        Partida* partida = &registros[i];
+        memset(partida, 0, sizeof(Partida));
+        memcpy(partida->nomeJogador, v2->nomeJogador, sizeof(partida->nomeJogador));
+        partida->numDiscos = v2->numDiscos;
+        partida->numMovimentos = v2->numMovimentos;
+        partida->numPinos = (versao >= 3) ? ((const PartidaV3*) antiga)->numPinos : 3;
+        if (versao == 4) {
+            partida->movimentosDesperdicados = ((const PartidaV4*) antiga)->movimentosDesperdicados;
+        } else {
+            uint64_t minimo = movimentosOtimosMultiPinos(partida->numDiscos, partida->numPinos);
+            partida->movimentosDesperdicados = ((uint64_t) partida->numMovimentos > minimo)
+                                               ? (int)((uint64_t) partida->numMovimentos - minimo) : 0;
         }
-        novoNo->partida = tempPartida;
-        novoNo->proximo = historicoGlobal->inicio;
-        historicoGlobal->inicio = novoNo;
+        partida->deslocamentoMovimentos = SEM_MOVIMENTOS;
     }
+    liberarRegistrosDoArquivo();
+    historicoGlobal->mapeamento = registros; // Bloco de malloc: liberado com free
+    historicoGlobal->registros = registros;
+    historicoGlobal->numRegistros = numRegistros;
+    salvarHistoricoTravado(nomeArquivo); // Compactação: regrava no formato atual
+}
 
-    fclose(arquivo);
+/**
+ * @brief Carrega o histórico de partidas de um arquivo binário.
+ * * No formato atual, o arquivo é mapeado na memória (mmap) e as partidas são lidas
+ * * diretamente do mapeamento, sem cópia e sem uma alocação por registro. Sem mmap
+ * * (Windows), o arquivo é lido inteiro em um único bloco.
+ * * Arquivos das versões 1 a 4 ou sem cabeçalho (formato antigo) são convertidos
+ * * para o formato atual e compactados logo em seguida.
+ * * Os índices de consulta são reconstruídos em seguida.
+ * @param nomeArquivo O nome do arquivo de onde o histórico será carregado.
+ */
+void carregarHistoricoDeArquivo(const char* nomeArquivo) {
+    travarHistorico(); // O gravador não liga nós nem indexa enquanto a lista é trocada
+    carregarRegistros(nomeArquivo);
+    reconstruirIndicesTravado();
+    destravarHistorico();
 }
 
 /**
@@ -176,12 +984,32 @@ void liberarHistoricoGlobal() {
     if (historicoGlobal == NULL) {
         return;
     }
+    if (gravadorAtivo) {
+        // O gravador termina as partidas pendentes antes de sair
+        pthread_mutex_lock(&travaGravador);
+        pararGravador = 1;
+        pthread_cond_signal(&condicaoPendentes);
+        pthread_mutex_unlock(&travaGravador);
+        pthread_join(threadGravador, NULL);
+        gravadorAtivo = 0;
+    }
     NoHistorico* atual = historicoGlobal->inicio;
     while (atual != NULL) {
         NoHistorico* temp = atual;
         atual = atual->proximo;
-        free(temp);
+        devolverAoPool(&poolNosHistorico, temp);
     }
+    liberarPool(&poolNosHistorico);
+    liberarRegistrosDoArquivo();
+    liberarIndices();
     free(historicoGlobal);
     historicoGlobal = NULL;
+}
+
+/**
+ * @brief Copia os contadores de alocação do pool de nós do histórico.
+ * * O carregamento do arquivo não passa pelo pool: ele usa o mapeamento (ou um único bloco).
+ */
+void obterEstatisticasHistorico(EstatisticasPool* nos) {
+    *nos = poolNosHistorico.estatisticas;
 }
\ No newline at end of file
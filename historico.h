@@ -1,19 +1,57 @@
 #ifndef HISTORICO_H
 #define HISTORICO_H
 
+#include <stdint.h> // Para os campos de tamanho fixo do cabeçalho
+
+#include <stddef.h> // Para size_t
+#include "pool.h"   // Para EstatisticasPool
+
+// Formato do arquivo de histórico: um cabeçalho seguido de registros Partida de tamanho fixo.
+// Novas partidas são apenas acrescentadas ao fim do arquivo (log somente de acréscimo), e o
+// arquivo pode ser mapeado na memória e lido diretamente como um vetor de Partida.
+#define HISTORICO_MAGICO "THNH"     // Identificador do arquivo (4 bytes)
+#define HISTORICO_VERSAO 5          // Versão atual do formato (3: numPinos; 4: movimentosDesperdicados; 5: gravação)
+#define TAMANHO_CABECALHO_V1 16     // A versão 1 não tinha o campo numRegistros
+
+// Arquivo com os movimentos de cada partida, gravados de forma compactada um após o outro.
+// Começa com HISTORICO_MOVIMENTOS_MAGICO e a versão (uint32_t); cada Partida guarda a posição
+// do início dos seus movimentos, e o tamanho sai de numPinos e numMovimentos.
+#define HISTORICO_MOVIMENTOS_MAGICO "THNM"
+#define HISTORICO_MOVIMENTOS_VERSAO 1
+
+// Partida sem gravação dos movimentos (formatos anteriores ou falha ao gravar)
+#define SEM_MOVIMENTOS UINT64_MAX
+
 // Estrutura para armazenar o resumo de uma partida
 typedef struct {
     char nomeJogador[50];    // Nome do jogador que jogou a partida
     int numDiscos;           // Número de discos usados nessa partida
     int numMovimentos;       // Total de movimentos feitos para completar a partida
+    int numPinos;            // Número de pinos usados nessa partida (3 nas versões 1 e 2 do arquivo)
+    int movimentosDesperdicados; // Movimentos além do mínimo necessário a partir da posição inicial
+    uint64_t deslocamentoMovimentos; // Posição dos movimentos no arquivo de movimentos (ou SEM_MOVIMENTOS)
 } Partida;
 
+// Cabeçalho gravado no início do arquivo de histórico
+typedef struct {
+    char magico[4];           // HISTORICO_MAGICO, sem o '\0'
+    uint32_t versao;          // HISTORICO_VERSAO
+    uint32_t tamanhoRegistro; // sizeof(Partida) de quem criou o arquivo
+    uint32_t reservado;       // Sempre zero nesta versão
+    uint64_t numRegistros;    // Registros válidos após o cabeçalho (versão 2 em diante)
+} CabecalhoHistorico;
+
 // Estrutura para gerenciar o histórico de movimentos de uma única partida
-// (usada temporariamente durante o jogo para contar movimentos)
+// (usada durante o jogo para gravar os movimentos, e para lê-los de volta depois).
+// Cada movimento ocupa bitsPorMovimento bits (3 com 3 pinos), em sequência, a partir
+// do bit menos significativo do primeiro byte do buffer.
 typedef struct {
     int numMovimentos;      // Total de movimentos para a partida atual
-    // Não precisamos de uma lista de movimentos individuais aqui,
-    // pois o objetivo é apenas armazenar o total para a Partida.
+    int movimentosDesperdicados; // Movimentos que não aproximaram a partida do objetivo
+    int numPinos;           // Pinos da partida (define o código de cada movimento)
+    int bitsPorMovimento;   // Largura do código de um movimento
+    uint8_t* movimentos;    // Movimentos compactados (NULL se a gravação falhou)
+    size_t capacidade;      // Bytes alocados em 'movimentos' (dobra quando enche)
 } HistoricoMovimentos;
 
 // Nó da lista encadeada para armazenar partidas no histórico GERAL
@@ -22,22 +60,48 @@ typedef struct NoHistorico {
     struct NoHistorico *proximo;
 } NoHistorico;
 
-// Estrutura do histórico global de partidas (lista encadeada)
+// Estrutura do histórico global de partidas.
+// As partidas já gravadas são vistas diretamente no arquivo mapeado (sem cópia);
+// as adicionadas durante a execução ficam na lista encadeada.
 typedef struct {
-    NoHistorico *inicio;
+    NoHistorico *inicio;          // Partidas adicionadas nesta execução (mais recente primeiro)
+    const Partida *registros;     // Partidas lidas do arquivo (mais antiga primeiro)
+    size_t numRegistros;          // Quantidade de partidas em 'registros'
+    void *mapeamento;             // Região mapeada do arquivo (ou bloco lido, sem mmap)
+    size_t tamanhoMapeamento;     // Tamanho da região mapeada; 0 se 'mapeamento' veio de malloc
 } HistoricoGlobal;
 
+// Função chamada para cada partida ao percorrer o histórico.
+// Deve retornar 0 para continuar ou qualquer outro valor para interromper.
+typedef int (*VisitantePartida)(const Partida* partida, void* contexto);
+
 // Variável global para o histórico, acessível por outras partes do programa
 extern HistoricoGlobal *historicoGlobal; 
 
 // Protótipos das funções
 void inicializarHistoricoGlobal();
-HistoricoMovimentos* criarHistoricoMovimentos();
+HistoricoMovimentos* criarHistoricoMovimentos(int numPinos);
 void liberarHistoricoMovimentos(HistoricoMovimentos* historico);
-void adicionarPartida(const char* nomeJogador, int numDiscos, HistoricoMovimentos* historicoPartida);
+int bitsPorMovimentoCompactado(int numPinos);
+size_t bytesMovimentosCompactados(int numPinos, size_t numMovimentos);
+int registrarMovimento(HistoricoMovimentos* historico, int origem, int destino);
+void decodificarMovimento(const uint8_t* dados, int numPinos, size_t indice, int* origem, int* destino);
+HistoricoMovimentos* lerMovimentosDaPartida(const Partida* partida);
+uint8_t* lerArquivoDeMovimentos(size_t* tamanho);
+void adicionarPartida(const char* nomeJogador, int numDiscos, int numPinos, HistoricoMovimentos* historicoPartida);
+void sincronizarHistorico();
+void travarHistorico();
+void destravarHistorico();
 void exibirHistorico();
+size_t totalPartidasHistorico();
+size_t totalPartidasHistoricoTravado();
+void percorrerHistorico(VisitantePartida visitante, void* contexto);
+void percorrerHistoricoTravado(VisitantePartida visitante, void* contexto);
+int obterPartidaPorPosicao(size_t posicao, Partida* partida);
 void salvarHistoricoEmArquivo(const char* nomeArquivo);
+int anexarPartidaAoArquivo(const char* nomeArquivo, const Partida* partida);
 void carregarHistoricoDeArquivo(const char* nomeArquivo);
 void liberarHistoricoGlobal();
+void obterEstatisticasHistorico(EstatisticasPool* nos);
 
 #endif // HISTORICO_H
\ No newline at end of file
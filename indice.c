@@ -0,0 +1,412 @@
+#include "indice.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "frame_stewart.h" // Mínimo de movimentos para k pinos, base da eficiência
+
+// Quantidade inicial de baldes da tabela hash de jogadores (sempre potência de 2)
+#define BALDES_INICIAIS 64
+
+// Classificações por número de pinos e de discos, e por número de discos com todos os pinos
+// (pela eficiência, que compara partidas com pinos diferentes)
+static Classificacao porDiscos[INDICE_NUM_PINOS][ESTADO_MAX_DISCOS + 1];
+static Classificacao porEficiencia[ESTADO_MAX_DISCOS + 1];
+
+// Índice por nome de jogador: tabela hash com encadeamento
+static EntradaJogador** baldes = NULL;
+static size_t numBaldes = 0;
+static size_t numJogadores = 0;
+
+// Retorna a classificação de uma combinação de discos e pinos (0 pinos: todos), ou NULL fora dos limites
+static Classificacao* classificacao(int numDiscos, int numPinos) {
+    if (numDiscos < 0 || numDiscos > ESTADO_MAX_DISCOS) {
+        return NULL;
+    }
+    if (numPinos == 0) {
+        return &porEficiencia[numDiscos];
+    }
+    if (numPinos < ESTADO_MIN_PINOS || numPinos > ESTADO_MAX_PINOS) {
+        return NULL;
+    }
+    return &porDiscos[numPinos - ESTADO_MIN_PINOS][numDiscos];
+}
+
+// Acrescenta uma referência ao fim de uma lista, dobrando a capacidade quando necessário
+static int acrescentar(ListaPartidas* lista, const Partida* partida) {
+    if (lista->quantidade == lista->capacidade) {
+        size_t novaCapacidade = (lista->capacidade == 0) ? 8 : lista->capacidade * 2;
+        const Partida** novosItens = (const Partida**) realloc(lista->itens, novaCapacidade * sizeof(Partida*));
+        if (novosItens == NULL) {
+            perror("Erro ao alocar memoria para o indice do historico");
+            return 0;
+        }
+        lista->itens = novosItens;
+        lista->capacidade = novaCapacidade;
+    }
+    lista->itens[lista->quantidade++] = partida;
+    return 1;
+}
+
+// Ordem de classificação: maior eficiência primeiro (com os mesmos pinos, menos movimentos);
+// empates por menos movimentos e depois pelo nome do jogador
+static int compararResultado(const ItemClassificacao* a, const ItemClassificacao* b) {
+    if (a->eficiencia != b->eficiencia) {
+        return (a->eficiencia > b->eficiencia) ? -1 : 1;
+    }
+    if (a->partida->numMovimentos != b->partida->numMovimentos) {
+        return (a->partida->numMovimentos < b->partida->numMovimentos) ? -1 : 1;
+    }
+    return strcmp(a->partida->nomeJogador, b->partida->nomeJogador);
+}
+
+static int compararResultadoQsort(const void* a, const void* b) {
+    return compararResultado((const ItemClassificacao*) a, (const ItemClassificacao*) b);
+}
+
+// Leva o item da posição 'i' para baixo até que os dois filhos sejam melhores que ele
+static void descerNoHeap(Classificacao* classificacao, size_t i) {
+    ItemClassificacao* itens = classificacao->itens;
+    while (1) {
+        size_t pior = i;
+        size_t esquerdo = 2 * i + 1, direito = 2 * i + 2;
+        if (esquerdo < classificacao->quantidade && compararResultado(&itens[esquerdo], &itens[pior]) > 0) {
+            pior = esquerdo;
+        }
+        if (direito < classificacao->quantidade && compararResultado(&itens[direito], &itens[pior]) > 0) {
+            pior = direito;
+        }
+        if (pior == i) {
+            return;
+        }
+        ItemClassificacao temp = itens[i];
+        itens[i] = itens[pior];
+        itens[pior] = temp;
+        i = pior;
+    }
+}
+
+// Oferece uma partida à classificação: entra se houver vaga ou se for melhor que a pior guardada
+static void classificar(Classificacao* classificacao, const ItemClassificacao* item) {
+    ItemClassificacao* itens = classificacao->itens;
+    if (classificacao->quantidade < INDICE_MAX_CLASSIFICACAO) {
+        // Sobe enquanto for pior que o pai (a raiz é a pior partida guardada)
+        size_t i = classificacao->quantidade++;
+        while (i > 0 && compararResultado(item, &itens[(i - 1) / 2]) > 0) {
+            itens[i] = itens[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        itens[i] = *item;
+    } else if (compararResultado(item, &itens[0]) < 0) {
+        itens[0] = *item;
+        descerNoHeap(classificacao, 0);
+    }
+}
+
+// Função hash FNV-1a para os nomes dos jogadores
+static size_t hashNome(const char* nome) {
+    size_t hash = (size_t) 2166136261u;
+    for (const unsigned char* c = (const unsigned char*) nome; *c != '\0'; c++) {
+        hash = (hash ^ *c) * (size_t) 16777619u;
+    }
+    return hash;
+}
+
+// Dobra a tabela hash quando há mais jogadores do que baldes
+static void redimensionarBaldes() {
+    size_t novoNumBaldes = (numBaldes == 0) ? BALDES_INICIAIS : numBaldes * 2;
+    EntradaJogador** novosBaldes = (EntradaJogador**) calloc(novoNumBaldes, sizeof(EntradaJogador*));
+    if (novosBaldes == NULL) {
+        return; // Continua com a tabela atual (mais colisões, mas correta)
+    }
+    for (size_t i = 0; i < numBaldes; i++) {
+        EntradaJogador* entrada = baldes[i];
+        while (entrada != NULL) {
+            EntradaJogador* proxima = entrada->proxima;
+            size_t destino = hashNome(entrada->nome) & (novoNumBaldes - 1);
+            entrada->proxima = novosBaldes[destino];
+            novosBaldes[destino] = entrada;
+            entrada = proxima;
+        }
+    }
+    free(baldes);
+    baldes = novosBaldes;
+    numBaldes = novoNumBaldes;
+}
+
+// Procura um jogador no índice; se 'criar' for 1, cria a entrada quando não existir
+static EntradaJogador* buscarJogador(const char* nome, int criar) {
+    if (numBaldes > 0) {
+        for (EntradaJogador* e = baldes[hashNome(nome) & (numBaldes - 1)]; e != NULL; e = e->proxima) {
+            if (strcmp(e->nome, nome) == 0) {
+                return e;
+            }
+        }
+    }
+    if (!criar) {
+        return NULL;
+    }
+    if (numJogadores >= numBaldes) {
+        redimensionarBaldes();
+        if (numBaldes == 0) {
+            return NULL;
+        }
+    }
+    EntradaJogador* nova = (EntradaJogador*) calloc(1, sizeof(EntradaJogador));
+    if (nova == NULL) {
+        perror("Erro ao alocar memoria para o indice de jogadores");
+        return NULL;
+    }
+    strncpy(nova->nome, nome, sizeof(nova->nome) - 1);
+    size_t balde = hashNome(nova->nome) & (numBaldes - 1);
+    nova->proxima = baldes[balde];
+    baldes[balde] = nova;
+    numJogadores++;
+    return nova;
+}
+
+// Atualiza o índice do jogador (lista de partidas e recorde pessoal)
+static void indexarJogador(const Partida* partida) {
+    EntradaJogador* jogador = buscarJogador(partida->nomeJogador, 1);
+    if (jogador == NULL) {
+        return;
+    }
+    acrescentar(&jogador->partidas, partida);
+    if (partida->numPinos == 0 || classificacao(partida->numDiscos, partida->numPinos) == NULL ||
+        eficienciaPartida(partida) <= 0.0) {
+        return; // Sem recorde para pinos inválidos nem para partidas impossíveis
+    }
+    const Partida** melhor = &jogador->melhorPorDiscos[partida->numPinos - ESTADO_MIN_PINOS][partida->numDiscos];
+    if (*melhor == NULL || partida->numMovimentos < (*melhor)->numMovimentos) {
+        *melhor = partida;
+    }
+}
+
+/**
+ * @brief Calcula a eficiência de uma partida: o mínimo de movimentos para os seus discos e
+ * * pinos (Frame–Stewart; 2^n - 1 com 3 pinos) dividido pelos movimentos feitos.
+ * @return Um valor entre 0 e 1 (1 é a solução ótima), ou 0 se a partida for impossível
+ * * (menos movimentos que o mínimo); essas partidas ficam fora das classificações.
+ */
+double eficienciaPartida(const Partida* partida) {
+    uint64_t minimo = movimentosOtimosMultiPinos(partida->numDiscos, partida->numPinos);
+    if (partida->numMovimentos < 0 || (uint64_t) partida->numMovimentos < minimo) {
+        return 0.0;
+    }
+    if (partida->numMovimentos == 0) {
+        return 1.0; // 0 discos: nada a mover
+    }
+    return (double) minimo / (double) partida->numMovimentos;
+}
+
+/**
+ * @brief Acrescenta uma partida aos índices (por jogador, por pinos e discos e por discos).
+ * * Usada por adicionarPartida e na reconstrução: as classificações são heaps limitados,
+ * * então cada partida custa O(log K), sem reordenar nada.
+ * @param partida A partida (deve continuar válida enquanto os índices existirem).
+ */
+void indexarPartida(const Partida* partida) {
+    indexarJogador(partida);
+
+    Classificacao* lista = classificacao(partida->numDiscos, partida->numPinos);
+    if (lista == NULL || partida->numPinos == 0) {
+        return;
+    }
+    ItemClassificacao item;
+    item.partida = partida;
+    item.eficiencia = eficienciaPartida(partida);
+    if (item.eficiencia <= 0.0) {
+        return; // Registro impossível (ex: importado com menos movimentos que o mínimo)
+    }
+    classificar(lista, &item);
+    classificar(&porEficiencia[partida->numDiscos], &item);
+}
+
+// Visitante usado na reconstrução
+static int indexarPartidaVisitada(const Partida* partida, void* contexto) {
+    (void) contexto;
+    indexarPartida(partida);
+    return 0;
+}
+
+/**
+ * @brief Reconstrói todos os índices a partir do histórico global.
+ * * As partidas são indexadas em uma passada, em O(N log K) para as classificações.
+ */
+void reconstruirIndices() {
+    travarHistorico();
+    reconstruirIndicesTravado();
+    destravarHistorico();
+}
+
+/**
+ * @brief Como reconstruirIndices, para quem já chamou travarHistorico
+ * * (carregarHistoricoDeArquivo, logo depois de carregar o arquivo).
+ */
+void reconstruirIndicesTravado() {
+    liberarIndices();
+    percorrerHistoricoTravado(indexarPartidaVisitada, NULL);
+
+    // percorrerHistorico vai da mais recente para a mais antiga: inverte as listas dos jogadores
+    for (size_t i = 0; i < numBaldes; i++) {
+        for (EntradaJogador* e = baldes[i]; e != NULL; e = e->proxima) {
+            for (size_t a = 0, b = e->partidas.quantidade; a + 1 < b; a++, b--) {
+                const Partida* temp = e->partidas.itens[a];
+                e->partidas.itens[a] = e->partidas.itens[b - 1];
+                e->partidas.itens[b - 1] = temp;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Libera toda a memória dos índices.
+ */
+void liberarIndices() {
+    for (int n = 0; n <= ESTADO_MAX_DISCOS; n++) {
+        for (int p = 0; p < INDICE_NUM_PINOS; p++) {
+            porDiscos[p][n].quantidade = 0;
+        }
+        porEficiencia[n].quantidade = 0;
+    }
+    for (size_t i = 0; i < numBaldes; i++) {
+        EntradaJogador* entrada = baldes[i];
+        while (entrada != NULL) {
+            EntradaJogador* proxima = entrada->proxima;
+            free(entrada->partidas.itens);
+            free(entrada);
+            entrada = proxima;
+        }
+    }
+    free(baldes);
+    baldes = NULL;
+    numBaldes = 0;
+    numJogadores = 0;
+}
+
+/**
+ * @brief Retorna as K melhores partidas para um número de discos e de pinos.
+ * * Só as partidas guardadas no heap (no máximo INDICE_MAX_CLASSIFICACAO) são ordenadas,
+ * * então o custo não depende do tamanho do histórico.
+ * @param numDiscos O número de discos.
+ * @param numPinos O número de pinos, ou 0 para todos (classificados pela eficiência).
+ * @param k Quantas partidas retornar, no máximo.
+ * @param saida Vetor com espaço para k itens.
+ * @return Quantas partidas foram escritas em 'saida', da melhor para a pior.
+ */
+size_t consultarMelhoresPorDiscos(int numDiscos, int numPinos, size_t k, ItemClassificacao* saida) {
+    Classificacao* lista = classificacao(numDiscos, numPinos);
+    if (lista == NULL) {
+        return 0;
+    }
+    ItemClassificacao ordenados[INDICE_MAX_CLASSIFICACAO];
+    travarHistorico(); // Inclui as partidas ainda com o gravador; o heap só é copiado
+    size_t guardadas = lista->quantidade;
+    memcpy(ordenados, lista->itens, guardadas * sizeof(ItemClassificacao));
+    destravarHistorico();
+    qsort(ordenados, guardadas, sizeof(ItemClassificacao), compararResultadoQsort);
+    size_t quantidade = (guardadas < k) ? guardadas : k;
+    memcpy(saida, ordenados, quantidade * sizeof(ItemClassificacao));
+    return quantidade;
+}
+
+/**
+ * @brief Retorna todas as partidas de um jogador, da mais antiga para a mais recente.
+ * * Deve ser chamada com o histórico travado (travarHistorico), e o vetor só pode ser
+ * * lido até destravarHistorico: o gravador pode realocá-lo ao indexar outra partida.
+ * @param nomeJogador O nome exato do jogador.
+ * @param partidas Recebe o vetor interno do índice (somente leitura).
+ * @return O número de partidas do jogador.
+ */
+size_t consultarPartidasDoJogador(const char* nomeJogador, const Partida* const** partidas) {
+    EntradaJogador* jogador = buscarJogador(nomeJogador, 0);
+    if (jogador == NULL) {
+        *partidas = NULL;
+        return 0;
+    }
+    *partidas = jogador->partidas.itens;
+    return jogador->partidas.quantidade;
+}
+
+/**
+ * @brief Retorna o recorde pessoal de um jogador para um número de discos e de pinos, ou NULL se não houver.
+ */
+const Partida* consultarRecordeDoJogador(const char* nomeJogador, int numDiscos, int numPinos) {
+    if (numPinos == 0 || classificacao(numDiscos, numPinos) == NULL) {
+        return NULL;
+    }
+    travarHistorico();
+    EntradaJogador* jogador = buscarJogador(nomeJogador, 0);
+    const Partida* recorde = (jogador != NULL) ? jogador->melhorPorDiscos[numPinos - ESTADO_MIN_PINOS][numDiscos] : NULL;
+    destravarHistorico();
+    return recorde;
+}
+
+/**
+ * @brief Exibe a classificação das K melhores partidas para um número de discos e de pinos
+ * * (0 pinos: todos os pinos juntos, pela eficiência).
+ */
+void exibirMelhoresPorDiscos(int numDiscos, int numPinos, size_t k) {
+    if (classificacao(numDiscos, numPinos) == NULL || k == 0) {
+        printf("\nConsulta invalida.\n");
+        return;
+    }
+    if (k > INDICE_MAX_CLASSIFICACAO) {
+        k = INDICE_MAX_CLASSIFICACAO;
+    }
+    ItemClassificacao melhores[INDICE_MAX_CLASSIFICACAO];
+    size_t quantidade = consultarMelhoresPorDiscos(numDiscos, numPinos, k, melhores);
+    if (numPinos == 0) {
+        printf("\n--- Melhores partidas com %d discos (todos os pinos, por eficiencia) ---\n", numDiscos);
+    } else {
+        printf("\n--- Melhores partidas com %d discos e %d pinos ---\n", numDiscos, numPinos);
+    }
+    if (quantidade == 0) {
+        printf("Nenhuma partida com %d discos.\n", numDiscos);
+    }
+    for (size_t i = 0; i < quantidade; i++) {
+        printf("%zu. Jogador: %s, Pinos: %d, Movimentos: %d, Eficiencia: %.1f%%\n", i + 1,
+               melhores[i].partida->nomeJogador, melhores[i].partida->numPinos, melhores[i].partida->numMovimentos,
+               100.0 * melhores[i].eficiencia);
+    }
+}
+
+/**
+ * @brief Exibe todas as partidas de um jogador, da mais recente para a mais antiga.
+ */
+void exibirPartidasDoJogador(const char* nomeJogador) {
+    const Partida* const* partidas;
+    travarHistorico();
+    size_t quantidade = consultarPartidasDoJogador(nomeJogador, &partidas);
+    printf("\n--- Partidas de %s ---\n", nomeJogador);
+    if (quantidade == 0) {
+        printf("Nenhuma partida registrada para este jogador.\n");
+    }
+    for (size_t i = quantidade; i > 0; i--) {
+        printf("%zu. Discos: %d, Pinos: %d, Movimentos: %d, Desperdicados: %d, Eficiencia: %.1f%%\n",
+               quantidade - i + 1, partidas[i - 1]->numDiscos, partidas[i - 1]->numPinos,
+               partidas[i - 1]->numMovimentos, partidas[i - 1]->movimentosDesperdicados,
+               100.0 * eficienciaPartida(partidas[i - 1]));
+    }
+    destravarHistorico();
+}
+
+/**
+ * @brief Exibe o recorde pessoal de um jogador para cada combinação de pinos e discos.
+ */
+void exibirRecordesDoJogador(const char* nomeJogador) {
+    printf("\n--- Recordes de %s ---\n", nomeJogador);
+    int encontrou = 0;
+    for (int p = ESTADO_MIN_PINOS; p <= ESTADO_MAX_PINOS; p++) {
+        for (int n = 0; n <= ESTADO_MAX_DISCOS; n++) {
+            const Partida* recorde = consultarRecordeDoJogador(nomeJogador, n, p);
+            if (recorde != NULL) {
+                printf("%d discos, %d pinos: %d movimentos\n", n, p, recorde->numMovimentos);
+                encontrou = 1;
+            }
+        }
+    }
+    if (!encontrou) {
+        printf("Nenhuma partida registrada para este jogador.\n");
+    }
+}
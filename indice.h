@@ -0,0 +1,55 @@
+#ifndef INDICE_H
+#define INDICE_H
+
+#include <stddef.h> // Para size_t
+#include "historico.h"
+#include "estado.h" // Para ESTADO_MAX_DISCOS e ESTADO_MIN_PINOS/ESTADO_MAX_PINOS
+
+// Quantidade de números de pinos possíveis (as classificações são separadas por pinos e discos)
+#define INDICE_NUM_PINOS (ESTADO_MAX_PINOS - ESTADO_MIN_PINOS + 1)
+
+// Partidas guardadas em cada classificação (consultas pedem no máximo este top K)
+#define INDICE_MAX_CLASSIFICACAO 100
+
+// Vetor dinâmico de referências para partidas do histórico
+typedef struct {
+    const Partida** itens;
+    size_t quantidade;
+    size_t capacidade;
+} ListaPartidas;
+
+// Uma partida classificada, com a eficiência já calculada
+typedef struct {
+    const Partida* partida;
+    double eficiencia; // Mínimo de movimentos para os discos e pinos da partida / movimentos feitos
+} ItemClassificacao;
+
+// Classificação limitada às INDICE_MAX_CLASSIFICACAO melhores partidas: heap com a pior delas
+// na raiz, então cada partida nova custa O(log K) e o resto do histórico não é guardado
+typedef struct {
+    ItemClassificacao itens[INDICE_MAX_CLASSIFICACAO];
+    size_t quantidade;
+} Classificacao;
+
+// Entrada do índice por jogador (encadeada dentro de um balde da tabela hash)
+typedef struct EntradaJogador {
+    char nome[50];                                           // Nome do jogador
+    ListaPartidas partidas;                                  // Partidas do jogador, da mais antiga para a mais recente
+    const Partida* melhorPorDiscos[INDICE_NUM_PINOS][ESTADO_MAX_DISCOS + 1]; // Recorde pessoal por pinos e discos
+    struct EntradaJogador* proxima;                          // Próxima entrada no mesmo balde
+} EntradaJogador;
+
+// Protótipos das funções de índice e consulta
+double eficienciaPartida(const Partida* partida);
+void indexarPartida(const Partida* partida);
+void reconstruirIndices();
+void reconstruirIndicesTravado();
+void liberarIndices();
+size_t consultarMelhoresPorDiscos(int numDiscos, int numPinos, size_t k, ItemClassificacao* saida);
+size_t consultarPartidasDoJogador(const char* nomeJogador, const Partida* const** partidas);
+const Partida* consultarRecordeDoJogador(const char* nomeJogador, int numDiscos, int numPinos);
+void exibirMelhoresPorDiscos(int numDiscos, int numPinos, size_t k);
+void exibirPartidasDoJogador(const char* nomeJogador);
+void exibirRecordesDoJogador(const char* nomeJogador);
+
+#endif // INDICE_H
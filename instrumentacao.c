@@ -0,0 +1,144 @@
+#include "instrumentacao.h"
+#include <stdio.h>
+
+#include "pilha.h"     // Para os contadores de alocação das pilhas
+#include "historico.h" // Para os contadores de alocação do histórico
+
+// Histograma de latência de uma fase
+typedef struct {
+    uint64_t faixas[INSTRUMENTACAO_FAIXAS]; // Contagem por potência de 2 de nanossegundos
+    uint64_t amostras;                      // Total de medidas
+    double totalSegundos;                   // Soma das medidas
+    double maiorSegundos;                   // Maior medida
+} HistogramaFase;
+
+static HistogramaFase histogramas[NUM_FASES];
+static uint64_t contadores[NUM_CONTADORES];
+
+static const char* nomesDasFases[NUM_FASES] = {
+    "entrada", "validacao", "aplicacao", "renderizacao", "vitoria", "limpar_tela"
+};
+
+static const char* nomesDosContadores[NUM_CONTADORES] = {
+    "bytes_historico", "gravacoes_historico"
+};
+
+// Índice da faixa de uma medida: posição do bit mais alto do valor em nanossegundos
+static int faixaDaMedida(double segundos) {
+    double ns = segundos * 1e9;
+    if (ns < 1.0) return 0;
+    uint64_t valor = (ns >= 1e18) ? (uint64_t)1e18 : (uint64_t) ns;
+    int faixa = 0;
+    while (valor > 1) {
+        valor >>= 1;
+        faixa++;
+    }
+    return (faixa < INSTRUMENTACAO_FAIXAS) ? faixa : INSTRUMENTACAO_FAIXAS - 1;
+}
+
+/**
+ * @brief Acrescenta uma medida de latência ao histograma da fase.
+ * @param fase A fase medida.
+ * @param segundos A duração medida.
+ */
+void instrumentacaoRegistrarFase(FaseInstrumentacao fase, double segundos) {
+    if ((int) fase < 0 || fase >= NUM_FASES) return;
+    HistogramaFase* h = &histogramas[fase];
+    h->faixas[faixaDaMedida(segundos)]++;
+    h->amostras++;
+    h->totalSegundos += segundos;
+    if (segundos > h->maiorSegundos) h->maiorSegundos = segundos;
+}
+
+/**
+ * @brief Soma um valor a um dos contadores da execução.
+ * @param contador O contador a ser incrementado.
+ * @param valor A quantidade somada.
+ */
+void instrumentacaoSomar(ContadorInstrumentacao contador, uint64_t valor) {
+    if ((int) contador < 0 || contador >= NUM_CONTADORES) return;
+    contadores[contador] += valor;
+}
+
+/**
+ * @brief Informa se os pontos de medição foram compilados (TORRE_INSTRUMENTACAO).
+ * @return 1 se a instrumentação está ativa neste executável, 0 caso contrário.
+ */
+int instrumentacaoCompilada() {
+#ifdef TORRE_INSTRUMENTACAO
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+// Limite superior (em ns) da faixa em que a fração 'quantil' das amostras é atingida
+static double percentil(const HistogramaFase* h, double quantil) {
+    double maior = h->maiorSegundos * 1e9;
+    uint64_t alvo = (uint64_t)(quantil * (double) h->amostras);
+    if ((double) alvo < quantil * (double) h->amostras || alvo == 0) alvo++; // Arredonda para cima
+    uint64_t acumulado = 0;
+    for (int i = 0; i < INSTRUMENTACAO_FAIXAS; i++) {
+        acumulado += h->faixas[i];
+        if (acumulado >= alvo) {
+            double limite = (double)((uint64_t)1 << (i + 1));
+            return (limite < maior) ? limite : maior;
+        }
+    }
+    return maior;
+}
+
+// Imprime os contadores de um pool de objetos
+static void exibirPool(FILE* destino, const char* nome, const EstatisticasPool* pool) {
+    fprintf(destino, "  %-18s obtidos=%zu devolvidos=%zu em_uso=%zu blocos_malloc=%zu\n",
+            nome, pool->obtidos, pool->devolvidos, pool->emUso, pool->alocacoesSistema);
+}
+
+/**
+ * @brief Imprime os histogramas por fase, as alocações e os contadores de gravação.
+ * * Os percentis são limites superiores das faixas do histograma (potências de 2 de ns).
+ * @param destino Onde escrever (ex: stderr).
+ */
+void instrumentacaoExibir(FILE* destino) {
+    fprintf(destino, "\n=== Estatisticas de execucao ===\n");
+    if (!instrumentacaoCompilada()) {
+        fprintf(destino, "Instrumentacao nao compilada (use make INSTRUMENTACAO=1); apenas alocacoes disponiveis.\n");
+    } else {
+        fprintf(destino, "Latencia por fase (ns):\n");
+        fprintf(destino, "  %-13s %10s %12s %10s %10s %10s %12s\n",
+                "fase", "amostras", "media", "p50<=", "p90<=", "p99<=", "maior");
+        for (int f = 0; f < NUM_FASES; f++) {
+            const HistogramaFase* h = &histogramas[f];
+            if (h->amostras == 0) {
+                fprintf(destino, "  %-13s %10d\n", nomesDasFases[f], 0);
+                continue;
+            }
+            fprintf(destino, "  %-13s %10llu %12.0f %10.0f %10.0f %10.0f %12.0f\n", nomesDasFases[f],
+                    (unsigned long long) h->amostras, h->totalSegundos * 1e9 / (double) h->amostras,
+                    percentil(h, 0.50), percentil(h, 0.90), percentil(h, 0.99), h->maiorSegundos * 1e9);
+        }
+        fprintf(destino, "Histogramas (faixa [2^i, 2^(i+1)) ns: amostras):\n");
+        for (int f = 0; f < NUM_FASES; f++) {
+            if (histogramas[f].amostras == 0) continue;
+            fprintf(destino, "  %s:", nomesDasFases[f]);
+            for (int i = 0; i < INSTRUMENTACAO_FAIXAS; i++) {
+                if (histogramas[f].faixas[i] != 0) {
+                    fprintf(destino, " %d:%llu", i, (unsigned long long) histogramas[f].faixas[i]);
+                }
+            }
+            fprintf(destino, "\n");
+        }
+        fprintf(destino, "Contadores:\n");
+        for (int c = 0; c < NUM_CONTADORES; c++) {
+            fprintf(destino, "  %-20s %llu\n", nomesDosContadores[c], (unsigned long long) contadores[c]);
+        }
+    }
+
+    EstatisticasPool nos, pilhas, nosHistorico;
+    obterEstatisticasPilha(&nos, &pilhas);
+    obterEstatisticasHistorico(&nosHistorico);
+    fprintf(destino, "Alocacoes:\n");
+    exibirPool(destino, "nos_pilha", &nos);
+    exibirPool(destino, "pilhas", &pilhas);
+    exibirPool(destino, "nos_historico", &nosHistorico);
+}
@@ -0,0 +1,47 @@
+#ifndef INSTRUMENTACAO_H
+#define INSTRUMENTACAO_H
+
+#include <stdio.h>  // Para FILE
+#include <stdint.h> // Para uint64_t
+
+// Fases medidas em cada volta do laço de jogar (e a limpeza da tela, medida onde ocorrer)
+typedef enum {
+    FASE_ENTRADA,      // Leitura e interpretação da linha digitada (inclui a espera pelo jogador)
+    FASE_VALIDACAO,    // Conversão das letras e teste de legalidade do movimento
+    FASE_APLICACAO,    // desempilhar + empilhar
+    FASE_RENDERIZACAO, // exibirTorres
+    FASE_VITORIA,      // verificarOrdemDiscos no pino de destino
+    FASE_LIMPAR_TELA,  // telaLimpar (chamada por clearScreen e pelas repinturas completas)
+    NUM_FASES
+} FaseInstrumentacao;
+
+// Contadores acumulados durante a execução
+typedef enum {
+    CONTADOR_BYTES_HISTORICO,     // Bytes gravados em historico.dat (compactação e acréscimos)
+    CONTADOR_GRAVACOES_HISTORICO, // Chamadas de salvarHistoricoEmArquivo e anexarPartidaAoArquivo
+    NUM_CONTADORES
+} ContadorInstrumentacao;
+
+// Faixas do histograma: a faixa i conta as medidas entre 2^i e 2^(i+1) - 1 nanossegundos
+#define INSTRUMENTACAO_FAIXAS 40
+
+// Protótipos do módulo de instrumentação
+void instrumentacaoRegistrarFase(FaseInstrumentacao fase, double segundos);
+void instrumentacaoSomar(ContadorInstrumentacao contador, uint64_t valor);
+int instrumentacaoCompilada();
+void instrumentacaoExibir(FILE* destino);
+
+// Macros usadas nos caminhos quentes. Sem TORRE_INSTRUMENTACAO (ex: make INSTRUMENTACAO=1)
+// elas não geram código, e o programa fica idêntico ao não instrumentado.
+#ifdef TORRE_INSTRUMENTACAO
+#include "cronometro.h"
+#define INSTR_INICIO(marca) double marca = cronometroSegundos()
+#define INSTR_FIM(fase, marca) instrumentacaoRegistrarFase((fase), cronometroSegundos() - (marca))
+#define INSTR_SOMAR(contador, valor) instrumentacaoSomar((contador), (uint64_t)(valor))
+#else
+#define INSTR_INICIO(marca) ((void)0)
+#define INSTR_FIM(fase, marca) ((void)0)
+#define INSTR_SOMAR(contador, valor) ((void)0)
+#endif
+
+#endif // INSTRUMENTACAO_H
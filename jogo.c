@@ -0,0 +1,299 @@
+#include "jogo.h"
+#include <stdio.h>    // Para funções de entrada/saída como printf, snprintf
+#include <stdlib.h>   // Para funções gerais como malloc, free
+#include <ctype.h>    // Para toupper, útil para converter letras para maiúsculas
+
+// Inclusão dos cabeçalhos das outras partes do projeto
+#include "historico.h" // Contém as definições e protótipos para o histórico de partidas
+#include "menu.h"      // Contém as definições e protótipos para o menu principal e funções auxiliares
+#include "estado.h"    // Contém o estado compacto (bitboard) das torres
+#include "solucionador.h" // Contém o analisador de posições usado pela dica
+#include "renderizador.h" // Contém o renderizador com buffer de quadro
+#include "cronometro.h" // Contém o relógio usado para medir o tempo por quadro
+#include "tela.h"      // Contém a camada de exibição com atualização incremental
+#include "frame_stewart.h" // Contém o mínimo de movimentos para k pinos
+#include "instrumentacao.h" // Contém os pontos de medição das fases de cada movimento
+#include "teclado.h"   // Contém a leitura de teclas sem Enter (modo bruto do terminal)
+
+// Acessa a variável global nomeJogadorAtual, que é definida em menu.c.
+extern char nomeJogadorAtual[50]; 
+
+// Buffer de quadro reaproveitado por todas as chamadas de exibirTorres
+static QuadroTela quadroDoJogo;
+
+/**
+ * @brief Exibe o estado atual de todas as torres e o contador de movimentos no console.
+ * * Monta o quadro inteiro em um buffer pré-alocado (ver renderizador.c) e o entrega
+ * * à camada de exibição (tela.c), que reescreve só as linhas que mudaram desde o
+ * * último quadro. O tempo gasto fica em quadroDoJogo.segundosUltimoQuadro.
+ * * @param pinos Array de ponteiros para Pilha, representando as torres.
+ * * @param numPinos O número de pinos da partida.
+ * * @param totalDiscosJogo O número total de discos usados nesta partida.
+ * * @param contadorMovimentos O número de movimentos feitos até agora.
+ */
+void exibirTorres(Pilha* pinos[], int numPinos, int totalDiscosJogo, int contadorMovimentos) {
+    // O buffer é alocado uma única vez, para o maior jogo possível
+    if (quadroDoJogo.dados == NULL && !inicializarQuadro(&quadroDoJogo, MAX_DISCOS, MAX_PINOS)) {
+        return;
+    }
+
+    double inicio = cronometroSegundos();
+    montarQuadroTorres(&quadroDoJogo, pinos, numPinos, totalDiscosJogo);
+    anexarAoQuadro(&quadroDoJogo, "Numero de movimentos: %d\n", contadorMovimentos);
+    telaAtualizar(quadroDoJogo.dados, quadroDoJogo.tamanho);
+    quadroDoJogo.segundosUltimoQuadro = cronometroSegundos() - inicio;
+}
+
+/**
+ * @brief Verifica se todos os discos estão na torre de destino na ordem correta.
+ * * No jogo da Torre de Hanói, o objetivo é ter todos os discos na torre final
+ * empilhados em ordem crescente (do menor para o maior, de cima para baixo).
+ * * @param torre Ponteiro para a Pilha que representa a torre de destino.
+ * @param numeroTotalDeDiscos O número total de discos na partida.
+ * @return 1 se a torre está completa e na ordem correta, 0 caso contrário.
+ */
+int verificarOrdemDiscos(Pilha* torre, int numeroTotalDeDiscos) {
+    // Se a torre está vazia, ela só pode ser considerada "completa e correta"
+    // se o número esperado de discos for 0 (o que não acontece na vitória).
+    if (pilhaVazia(torre)) {
+        return (numeroTotalDeDiscos == 0);
+    }
+
+    // No motor bitboard a ordem é garantida pela representação: basta comparar a máscara
+    if (torre->motor == MOTOR_BITBOARD) {
+        return torre->discos == estadoMascaraCompleta(numeroTotalDeDiscos);
+    }
+
+    No* noAtual = torre->topo; // Começa pelo topo da pilha (menor disco)
+    int discosContados = 0;
+    int proximoTamanhoEsperado = 1; // O menor disco é o de tamanho 1
+
+    // Percorre a pilha, verificando a ordem dos discos
+    while (noAtual != NULL) {
+        // Se o tamanho do disco atual não corresponder ao esperado, a ordem está incorreta
+        if (noAtual->tamanhoDisco != proximoTamanhoEsperado) {
+            return 0; // Ordem inválida
+        }
+        proximoTamanhoEsperado++; // Espera o próximo disco maior
+        discosContados++;         // Conta os discos empilhados
+        noAtual = noAtual->abaixo; // Move para o próximo disco na pilha
+    }
+    // Retorna verdadeiro se o número de discos contados na torre é igual ao total de discos do jogo
+    return (discosContados == numeroTotalDeDiscos);
+}
+
+/**
+ * @brief Converte uma letra de pino ('A', 'B', 'C', ...) para seu índice numérico (0, 1, 2, ...).
+ * * @param letra A letra do pino (maiúscula ou minúscula).
+ * @param numPinos O número de pinos da partida (letras além do último pino são inválidas).
+ * @return O índice do pino (0 para A, 1 para B, ...), ou -1 se a letra for inválida.
+ */
+int obterIndiceDoPino(char letra, int numPinos) {
+    letra = toupper(letra); // Converte a letra para maiúscula para padronização
+    if (letra >= 'A' && letra < 'A' + numPinos) return letra - 'A';
+    return -1; // Retorna -1 para letras inválidas
+}
+
+/**
+ * @brief Implementa a lógica principal do jogo Torre de Hanói.
+ * * Gerencia o estado dos pinos, a interação do jogador, a contagem de movimentos
+ * e a verificação das condições de vitória e saída.
+ * * Cada movimento são duas teclas (origem e destino), lidas sem Enter; avisos não pausam o
+ * * jogo e aparecem junto do próximo quadro.
+ * * @param numDiscos O número de discos para a partida atual.
+ * * @param numPinos O número de pinos para a partida atual (o último é o destino).
+ */
+void jogar(int numDiscos, int numPinos) {
+    // Array para armazenar os ponteiros para as pilhas (pinos A, B, C, ...)
+    Pilha* pinosDoJogo[MAX_PINOS] = {NULL};
+    int pinoDestino = numPinos - 1; // O último pino é o destino
+    
+    // Cria um objeto HistoricoMovimentos para gravar os movimentos da partida.
+    // Cada movimento ocupa poucos bits (3 com 3 pinos), então uma partida inteira cabe em poucos bytes.
+    HistoricoMovimentos* historicoPartida = criarHistoricoMovimentos(numPinos); 
+    int contadorMovimentos = 0; // Inicializa o contador de movimentos para esta partida
+
+    // Verifica se a alocação de memória para o histórico foi bem-sucedida.
+    if (historicoPartida == NULL) {
+        fprintf(stderr, "Erro: Nao foi possivel alocar memoria para o historico da partida.\n");
+        return; // Aborta a função se não conseguir criar o histórico
+    }
+
+    // Inicializa os pinos (torres) A, B, C, ...
+    int pinosCriados = 1;
+    for (int i = 0; i < numPinos; i++) {
+        pinosDoJogo[i] = criarPilha((char)('A' + i));
+        if (pinosDoJogo[i] == NULL) pinosCriados = 0;
+    }
+
+    // Verifica se a alocação de memória para os pinos foi bem-sucedida.
+    // Se falhar, libera o que já foi alocado e retorna.
+    if (!pinosCriados) {
+        fprintf(stderr, "Erro: Nao foi possivel criar uma ou mais pilhas para o jogo.\n");
+        for (int i = 0; i < numPinos; i++) {
+            if (pinosDoJogo[i] != NULL) liberarPilha(pinosDoJogo[i]);
+        }
+        liberarHistoricoMovimentos(historicoPartida); // Libera o histórico alocado
+        return;
+    }
+
+    // Empilha todos os discos no primeiro pino (Pino A) em ordem decrescente (maior embaixo)
+    for (int i = numDiscos; i >= 1; i--) {
+        empilhar(pinosDoJogo[0], i);
+    }
+
+    // Mínimo de movimentos a partir da posição inicial: base para os movimentos desperdiçados.
+    // Com 3 pinos vem do analisador de posições; com mais pinos, da tabela de Frame–Stewart.
+    AnalisePosicao analise;
+    uint64_t distanciaInicial = (analisarPilhas(pinosDoJogo, numPinos, numDiscos, pinoDestino, &analise) == 0)
+                                ? analise.movimentosRestantes
+                                : movimentosOtimosMultiPinos(numDiscos, numPinos);
+
+    int indiceOrigem, indiceDestino; // Índices numéricos dos pinos de origem e destino
+    int discoSendoMovido;           // Armazena o tamanho do disco que está sendo movido
+    int pinoSelecionado = -1;       // Origem já digitada, esperando a tecla do destino
+    char mensagem[160] = "";        // Aviso (movimento inválido, dica) exibido no próximo quadro
+
+    // Loop principal do jogo: cada movimento são duas teclas, sem Enter (ver teclado.c)
+    while (1) {
+        // Condição de vitória: todos os discos no último pino e na ordem correta
+        // (se o destino tem todos os discos, os demais pinos estão vazios)
+        INSTR_INICIO(inicioVitoria);
+        int venceu = verificarOrdemDiscos(pinosDoJogo[pinoDestino], numDiscos);
+        INSTR_FIM(FASE_VITORIA, inicioVitoria);
+
+        // Teclas que já chegaram (sequência colada ou entrada redirecionada) são aplicadas
+        // sem redesenhar entre elas; o quadro só é montado quando a entrada se esgota
+        int redesenhar = venceu || !tecladoTeclaPendente();
+        if (redesenhar) {
+            // Atualiza as torres e a contagem de movimentos (só as linhas que mudaram)
+            INSTR_INICIO(inicioRenderizacao);
+            exibirTorres(pinosDoJogo, numPinos, numDiscos, contadorMovimentos);
+            INSTR_FIM(FASE_RENDERIZACAO, inicioRenderizacao);
+        }
+        if (venceu) {
+            printf("\nParabéns, %s! Você concluiu o jogo com %d movimentos!\n", nomeJogadorAtual, contadorMovimentos);
+
+            // Antes de adicionar ao histórico, atualizamos o número de movimentos no objeto historicoPartida
+            historicoPartida->numMovimentos = contadorMovimentos; 
+            // Cada movimento que não reduziu a distância até o objetivo foi desperdiçado; como a
+            // distância final é zero, a soma é o total de movimentos menos a distância inicial.
+            historicoPartida->movimentosDesperdicados = contadorMovimentos - (int) distanciaInicial;
+            printf("Movimentos desperdicados: %d (minimo: %llu)\n", historicoPartida->movimentosDesperdicados,
+                   (unsigned long long) distanciaInicial);
+            adicionarPartida(nomeJogadorAtual, numDiscos, numPinos, historicoPartida); // Registra o resumo da partida no histórico global
+            
+            // Libera a memória alocada para as pilhas do jogo
+            for (int i = 0; i < numPinos; i++) {
+                liberarPilha(pinosDoJogo[i]);
+            }
+
+            printf("Pressione Enter para voltar ao menu...");
+            tecladoEsperarEnter(); // Espera a confirmação do jogador
+            break; // Sai do loop principal do jogo
+        }
+
+        if (redesenhar) {
+            if (mensagem[0] != '\0') {
+                printf("\n%s", mensagem);
+                mensagem[0] = '\0';
+            }
+            printf("\nMovimento (duas teclas, ex: A e B), H: dica, R: reiniciar, Q: sair: ");
+            if (pinoSelecionado >= 0) {
+                printf("%c", 'A' + pinoSelecionado); // Eco da origem já escolhida
+            }
+        }
+
+        INSTR_INICIO(inicioEntrada);
+        int tecla = tecladoLerTecla(); // Uma tecla, sem esperar pelo Enter
+        INSTR_FIM(FASE_ENTRADA, inicioEntrada);
+        if (tecla == EOF || tecla == 4) {
+            tecla = 'Q'; // Fim da entrada (ou Ctrl+D): encerra a partida
+        }
+        // Espaços e Enter entre os movimentos são ignorados (ex: "AB\nBC" em um arquivo)
+        if (tecla == ' ' || tecla == '\n' || tecla == '\r' || tecla == '\t' || tecla == ',') {
+            continue;
+        }
+
+        int indicePino = (tecla < 0x80) ? obterIndiceDoPino((char) tecla, numPinos) : -1;
+        if (indicePino < 0) {
+            pinoSelecionado = -1; // Qualquer outra tecla cancela a origem escolhida
+            tecla = toupper(tecla);
+
+            // Opção para Sair do jogo
+            if (tecla == 'Q') {
+                printf("\nSaindo do jogo atual...\n");
+                liberarHistoricoMovimentos(historicoPartida); // Libera a memória do histórico desta partida
+                // Libera a memória das pilhas antes de sair
+                for (int i = 0; i < numPinos; i++) {
+                    liberarPilha(pinosDoJogo[i]);
+                }
+                break; // Sai do loop principal do jogo
+            }
+            // Opção de dica: distância até o objetivo e melhor próximo movimento, sem busca
+            // ('?' também serve, já que com 8 pinos 'H' é o último pino)
+            if (tecla == 'H' || tecla == '?') {
+                if (analisarPilhas(pinosDoJogo, numPinos, numDiscos, pinoDestino, &analise) == 0) {
+                    snprintf(mensagem, sizeof(mensagem), "Dica: mova de %c para %c (faltam no minimo %llu movimentos).",
+                             'A' + analise.proximo.origem, 'A' + analise.proximo.destino,
+                             (unsigned long long) analise.movimentosRestantes);
+                } else {
+                    snprintf(mensagem, sizeof(mensagem), "Dica disponivel apenas com 3 pinos.");
+                }
+                continue; // Volta ao início do loop para nova entrada
+            }
+            // Opção para Reiniciar o jogo
+            if (tecla == 'R') {
+                printf("\nReiniciando jogo...\n");
+                liberarHistoricoMovimentos(historicoPartida); // Libera o histórico da partida atual
+                // Libera as pilhas antes de reiniciar
+                for (int i = 0; i < numPinos; i++) {
+                    liberarPilha(pinosDoJogo[i]);
+                }
+                jogar(numDiscos, numPinos); // Chama a função jogar recursivamente para iniciar uma nova partida
+                return; // Retorna da chamada atual de jogar para evitar continuar o loop anterior
+            }
+            // Esc, Backspace e setas só cancelam a origem; o resto é avisado no próximo quadro
+            if (tecla != 27 && tecla != 8 && tecla != 127 && tecla != TECLADO_TECLA_ESPECIAL) {
+                snprintf(mensagem, sizeof(mensagem), "Tecla invalida! Use as letras dos pinos (A a %c), H, R ou Q.",
+                         'A' + numPinos - 1);
+            }
+            continue;
+        }
+
+        // Primeira tecla: guarda a origem e espera o destino
+        if (pinoSelecionado < 0) {
+            pinoSelecionado = indicePino;
+            continue;
+        }
+        indiceOrigem = pinoSelecionado;
+        indiceDestino = indicePino;
+        pinoSelecionado = -1;
+
+        // Validação do movimento
+        // 1. Origem e destino são pinos diferentes
+        // 2. Pino de origem não está vazio
+        // 3. Se o pino de destino não está vazio, o disco a ser movido deve ser menor que o disco no topo do destino.
+        INSTR_INICIO(inicioValidacao);
+        if (indiceOrigem == indiceDestino || pilhaVazia(pinosDoJogo[indiceOrigem]) ||
+            (topoDisco(pinosDoJogo[indiceDestino]) != -1 && topoDisco(pinosDoJogo[indiceDestino]) < topoDisco(pinosDoJogo[indiceOrigem]))) {
+            INSTR_FIM(FASE_VALIDACAO, inicioValidacao);
+            // Sem pausa: o aviso aparece junto do próximo quadro
+            snprintf(mensagem, sizeof(mensagem), "Movimento invalido: %c para %c.", 'A' + indiceOrigem,
+                     'A' + indiceDestino);
+            continue; // Volta ao início do loop para nova entrada
+        }
+
+        INSTR_FIM(FASE_VALIDACAO, inicioValidacao);
+
+        // Executa o movimento válido
+        INSTR_INICIO(inicioAplicacao);
+        discoSendoMovido = desempilhar(pinosDoJogo[indiceOrigem]); // Tira o disco do pino de origem
+        empilhar(pinosDoJogo[indiceDestino], discoSendoMovido);   // Coloca o disco no pino de destino
+        INSTR_FIM(FASE_APLICACAO, inicioAplicacao);
+        contadorMovimentos++; // Incrementa o contador de movimentos
+        // Grava o movimento na forma compactada (também conta o movimento no histórico da partida)
+        registrarMovimento(historicoPartida, indiceOrigem, indiceDestino);
+    }
+}
+
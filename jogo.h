@@ -0,0 +1,12 @@
+#ifndef JOGO_H
+#define JOGO_H
+
+#include "pilha.h" // Para Pilha
+
+// Protótipos da partida interativa
+void exibirTorres(Pilha* pinos[], int numPinos, int totalDiscosJogo, int contadorMovimentos);
+int verificarOrdemDiscos(Pilha* torre, int numeroTotalDeDiscos);
+int obterIndiceDoPino(char letra, int numPinos);
+void jogar(int numDiscos, int numPinos);
+
+#endif // JOGO_H
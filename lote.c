@@ -0,0 +1,174 @@
+#include "lote.h"
+#include "estado.h"
+#include "cronometro.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Tamanho do bloco lido de uma vez da entrada
+#define TAMANHO_BUFFER_LOTE (1 << 16)
+
+// Tabela letra -> índice do pino (-1 para letras que não são pinos)
+static signed char indicePorLetra[256];
+static int tabelaPronta = 0;
+
+static void montarTabelaLetras() {
+    memset(indicePorLetra, -1, sizeof(indicePorLetra));
+    for (int i = 0; i < ESTADO_MAX_PINOS; i++) {
+        indicePorLetra['A' + i] = (signed char)i;
+        indicePorLetra['a' + i] = (signed char)i;
+    }
+    tabelaPronta = 1;
+}
+
+// Separadores entre movimentos: espaço, tabulação, quebras de linha, vírgula e ponto e vírgula
+static inline int ehSeparador(unsigned char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == ',' || c == ';';
+}
+
+/**
+ * @brief Processa uma palavra da entrada (ex: "AB", "R" ou "Q") sobre o estado.
+ * @return 0 para continuar, 1 se o jogador saiu ('Q').
+ */
+static int processarPalavra(EstadoTorres* estado, ResultadoLote* resultado, uint64_t* lidos,
+                            const unsigned char* palavra, int tamanho) {
+    if (tamanho == 1 && (palavra[0] == 'Q' || palavra[0] == 'q')) {
+        return 1;
+    }
+    if (tamanho == 1 && (palavra[0] == 'R' || palavra[0] == 'r')) {
+        // Reiniciar: mesma regra do jogo interativo, a contagem volta a zero
+        inicializarEstado(estado, estado->numDiscos, estado->numPinos, 0);
+        resultado->movimentos = 0;
+        resultado->vitoria = 0;
+        return 0;
+    }
+
+    (*lidos)++;
+    if (resultado->vitoria) {
+        resultado->ignorados++; // O jogo já terminou
+        return 0;
+    }
+    if (tamanho == 2 && estadoMover(estado, indicePorLetra[palavra[0]], indicePorLetra[palavra[1]]) != -1) {
+        resultado->movimentos++;
+        resultado->vitoria = estadoConcluido(estado, estado->numPinos - 1); // Destino: último pino
+        return 0;
+    }
+    // Entrada inválida ou movimento proibido: rejeitado, como no jogo interativo
+    resultado->invalidos++;
+    if (resultado->primeiroInvalido == 0) {
+        resultado->primeiroInvalido = *lidos;
+    }
+    return 0;
+}
+
+/**
+ * @brief Aplica uma sequência de movimentos lida de 'entrada' sem renderização nem pausas.
+ * * A entrada é lida em blocos grandes e interpretada palavra por palavra ("AB AC BC ...").
+ * * As regras de validação são as do jogo: origem não vazia e disco menor sobre disco maior.
+ * * A partida termina quando todos os discos chegam ao último pino.
+ * * "R" reinicia a partida e "Q" encerra a leitura.
+ * @param entrada O arquivo de onde os movimentos são lidos.
+ * @param numDiscos O número de discos da partida (1 a ESTADO_MAX_DISCOS).
+ * @param numPinos O número de pinos da partida (ESTADO_MIN_PINOS a ESTADO_MAX_PINOS).
+ * @param resultado Estrutura preenchida com o veredito e as contagens.
+ * @return 0 em caso de sucesso, 1 em caso de erro de parâmetro ou de alocação.
+ */
+int processarLote(FILE* entrada, int numDiscos, int numPinos, ResultadoLote* resultado) {
+    memset(resultado, 0, sizeof(ResultadoLote));
+    if (numDiscos < 1 || numDiscos > ESTADO_MAX_DISCOS) {
+        fprintf(stderr, "Erro: numero de discos deve estar entre 1 e %d.\n", ESTADO_MAX_DISCOS);
+        return 1;
+    }
+    if (numPinos < ESTADO_MIN_PINOS || numPinos > ESTADO_MAX_PINOS) {
+        fprintf(stderr, "Erro: numero de pinos deve estar entre %d e %d.\n", ESTADO_MIN_PINOS, ESTADO_MAX_PINOS);
+        return 1;
+    }
+    if (!tabelaPronta) {
+        montarTabelaLetras();
+    }
+
+    unsigned char* buffer = (unsigned char*) malloc(TAMANHO_BUFFER_LOTE);
+    if (buffer == NULL) {
+        perror("Erro ao alocar memoria para o modo em lote");
+        return 1;
+    }
+
+    EstadoTorres estado;
+    inicializarEstado(&estado, numDiscos, numPinos, 0);
+
+    unsigned char palavra[2]; // Só os dois primeiros caracteres importam
+    int tamanhoPalavra = 0;   // Tamanho real da palavra atual (pode passar de 2)
+    uint64_t lidos = 0;       // Movimentos lidos, para localizar o primeiro inválido
+    int sair = 0;
+
+    double inicio = cronometroSegundos();
+    size_t quantidade;
+    while (!sair && (quantidade = fread(buffer, 1, TAMANHO_BUFFER_LOTE, entrada)) > 0) {
+        for (size_t i = 0; i < quantidade; i++) {
+            unsigned char c = buffer[i];
+            if (!ehSeparador(c)) {
+                if (tamanhoPalavra < 2) {
+                    palavra[tamanhoPalavra] = c;
+                }
+                tamanhoPalavra++;
+                continue;
+            }
+            if (tamanhoPalavra > 0) {
+                sair = processarPalavra(&estado, resultado, &lidos, palavra, tamanhoPalavra);
+                tamanhoPalavra = 0;
+                if (sair) {
+                    break;
+                }
+            }
+        }
+    }
+    // Última palavra, se a entrada não terminar com separador
+    if (!sair && tamanhoPalavra > 0) {
+        processarPalavra(&estado, resultado, &lidos, palavra, tamanhoPalavra);
+    }
+    resultado->segundos = cronometroSegundos() - inicio;
+
+    free(buffer);
+    return 0;
+}
+
+/**
+ * @brief Modo em lote: lê movimentos de um arquivo (ou da entrada padrão) e imprime o veredito.
+ * @param numDiscos O número de discos da partida.
+ * @param numPinos O número de pinos da partida.
+ * @param caminhoArquivo Caminho do arquivo de movimentos; NULL ou "-" para a entrada padrão.
+ * @return 0 se a partida terminou em vitória, 2 se não terminou, 1 em caso de erro.
+ */
+int executarModoLote(int numDiscos, int numPinos, const char* caminhoArquivo) {
+    FILE* entrada = stdin;
+    if (caminhoArquivo != NULL && strcmp(caminhoArquivo, "-") != 0) {
+        entrada = fopen(caminhoArquivo, "rb");
+        if (entrada == NULL) {
+            perror("Erro ao abrir arquivo de movimentos");
+            return 1;
+        }
+    }
+
+    ResultadoLote resultado;
+    int erro = processarLote(entrada, numDiscos, numPinos, &resultado);
+    if (entrada != stdin) {
+        fclose(entrada);
+    }
+    if (erro) {
+        return 1;
+    }
+
+    uint64_t processados = resultado.movimentos + resultado.invalidos + resultado.ignorados;
+    printf("Resultado: %s\n", resultado.vitoria ? "VITORIA" : "INCOMPLETO");
+    printf("Movimentos: %llu\n", (unsigned long long)resultado.movimentos);
+    printf("Invalidos: %llu", (unsigned long long)resultado.invalidos);
+    if (resultado.primeiroInvalido != 0) {
+        printf(" (primeiro no movimento %llu)", (unsigned long long)resultado.primeiroInvalido);
+    }
+    printf("\n");
+    if (resultado.ignorados != 0) {
+        printf("Ignorados apos a vitoria: %llu\n", (unsigned long long)resultado.ignorados);
+    }
+    fprintf(stderr, "%llu movimentos em %.3f s (%.0f mov/s)\n", (unsigned long long)processados,
+            resultado.segundos, resultado.segundos > 0 ? (double)processados / resultado.segundos : 0.0);
+    return resultado.vitoria ? 0 : 2;
+}
@@ -0,0 +1,21 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <stdio.h>  // Para FILE
+#include <stdint.h> // Para uint64_t
+
+// Resultado de uma partida processada em lote
+typedef struct {
+    int vitoria;                  // 1 se todos os discos chegaram ao último pino
+    uint64_t movimentos;          // Movimentos válidos aplicados
+    uint64_t invalidos;           // Movimentos rejeitados pelas regras
+    uint64_t primeiroInvalido;    // Posição (começando em 1) do primeiro movimento rejeitado, 0 se nenhum
+    uint64_t ignorados;           // Movimentos lidos depois da vitória
+    double segundos;              // Tempo de processamento
+} ResultadoLote;
+
+// Protótipos das funções do modo em lote
+int processarLote(FILE* entrada, int numDiscos, int numPinos, ResultadoLote* resultado);
+int executarModoLote(int numDiscos, int numPinos, const char* caminhoArquivo);
+
+#endif // LOTE_H
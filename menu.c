@@ -1,31 +1,64 @@
 #include "menu.h"
 #include "historico.h" // Necessário para exibirHistorico e outras funções do histórico
-#include "pilha.h"     // Necessário para a função jogar
+#include "jogo.h"      // Necessário para a função jogar
+#include "tela.h"      // Necessário para limpar a tela sem criar processos
+#include "indice.h"    // Necessário para as consultas de classificação do histórico
+#include "reproducao.h" // Necessário para reproduzir partidas gravadas
+#include "teclado.h"   // Necessário para ler linhas e teclas da entrada
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h> // Necessário para strlen, strcspn
 
 // Variável global para armazenar o nome do jogador atual
 char nomeJogadorAtual[50];
 
 /**
- * @brief Limpa a tela do console, dependendo do sistema operacional.
+ * @brief Limpa a tela do console com sequências ANSI, sem chamar system().
+ * * Em consoles do Windows sem suporte a ANSI, recorre a system("cls") (ver tela.c).
  */
 void clearScreen() {
-#ifdef _WIN32
-    system("cls"); // Para Windows
-#else
-    system("clear"); // Para Linux/macOS
-#endif
+    telaLimpar();
 }
 
 /**
- * @brief Limpa o buffer de entrada (stdin) para evitar leituras indesejadas.
- * * Usado após scanf ou antes de fgets para garantir que o buffer esteja vazio.
+ * @brief Lê um número inteiro em uma linha inteira da entrada.
+ * @param valor Recebe o número lido.
+ * @return 1 se a linha tinha um número, 0 se não tinha, -1 no fim da entrada.
  */
-void limparBufferEntrada() {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF);
+static int lerInteiro(int* valor) {
+    char linha[32];
+    if (!tecladoLerLinha(linha, sizeof(linha))) {
+        return -1;
+    }
+    char* fim;
+    long numero = strtol(linha, &fim, 10);
+    while (*fim == ' ' || *fim == '\t') fim++;
+    if (fim == linha || *fim != '\0') {
+        return 0;
+    }
+    *valor = (int) numero;
+    return 1;
+}
+
+/**
+ * @brief Pergunta um número até que ele esteja no intervalo permitido.
+ * @param pergunta O texto exibido antes de cada leitura.
+ * @param nome O que está sendo escolhido (para a mensagem de erro).
+ * @return 1 com o número em 'valor', 0 no fim da entrada.
+ */
+static int lerNumeroNoIntervalo(const char* pergunta, const char* nome, int minimo, int maximo, int* valor) {
+    while (1) {
+        printf("%s (%d a %d): ", pergunta, minimo, maximo);
+        int lido = lerInteiro(valor);
+        if (lido < 0) {
+            return 0;
+        } else if (lido == 0) {
+            printf("Entrada invalida. Digite um numero.\n");
+        } else if (*valor < minimo || *valor > maximo) {
+            printf("Numero de %s fora do intervalo permitido.\n", nome);
+        } else {
+            return 1;
+        }
+    }
 }
 
 /**
@@ -41,13 +74,70 @@ void exibirInstrucoes() {
     printf("2. Um disco maior nunca pode ser colocado em cima de um disco menor.\n");
     printf("3. Cada movimento consiste em pegar o disco superior de um pino\n");
     printf("   e coloca-lo no topo de outro pino.\n\n");
-    printf("Voce digita o movimento como duas letras, por exemplo: 'AB'\n");
-    printf("para mover o disco do pino A para o pino B.\n\n");
-    printf("Pinos: A (origem), B (auxiliar), C (destino).\n");
+    printf("Voce digita o movimento como duas teclas, sem Enter: 'A' e depois 'B'\n");
+    printf("movem o disco do pino A para o pino B. Movimentos colados de uma vez\n");
+    printf("(ex: ACABCB) sao aplicados em sequencia.\n\n");
+    printf("Pinos: A (origem), B e os demais (auxiliares), o ultimo (destino).\n");
+    printf("Com 3 pinos o destino e C; com mais pinos (ate %d) o destino e o ultimo\n", MAX_PINOS);
+    printf("e a partida pode ser resolvida com menos movimentos.\n");
     printf("----------------------------------\n");
     printf("Pressione Enter para voltar ao menu...");
-    limparBufferEntrada(); // Garante que o buffer esteja limpo
-    getchar(); // Espera o usuário pressionar Enter
+    tecladoEsperarEnter(); // Espera o usuário pressionar Enter
+}
+
+/**
+ * @brief Exibe o histórico de partidas e as consultas de classificação.
+ * * Permite ver as melhores partidas para um número de discos, todas as partidas
+ * * de um jogador, os recordes pessoais de um jogador e reproduzir uma partida gravada.
+ */
+void exibirTelaHistorico() {
+    char entrada[50];
+    clearScreen();
+    exibirHistorico();
+    while (1) {
+        printf("\n1. Melhores partidas por numero de discos e pinos\n");
+        printf("2. Partidas de um jogador\n");
+        printf("3. Recordes de um jogador\n");
+        printf("4. Reproduzir uma partida\n");
+        printf("Escolha uma consulta ou pressione Enter para voltar ao menu: ");
+        if (!tecladoLerLinha(entrada, sizeof(entrada)) || entrada[0] == '\0') {
+            return;
+        }
+        int consulta = atoi(entrada);
+        if (consulta == 1) {
+            printf("Numero de discos: ");
+            if (!tecladoLerLinha(entrada, sizeof(entrada))) return;
+            int numDiscos = atoi(entrada);
+            printf("Numero de pinos (Enter para todos, pela eficiencia): ");
+            if (!tecladoLerLinha(entrada, sizeof(entrada))) return;
+            int numPinos = (entrada[0] == '\0') ? 0 : atoi(entrada);
+            printf("Quantas partidas (top K, ate %d): ", INDICE_MAX_CLASSIFICACAO);
+            if (!tecladoLerLinha(entrada, sizeof(entrada))) return;
+            int k = atoi(entrada);
+            exibirMelhoresPorDiscos(numDiscos, numPinos, (size_t)(k > 0 ? k : 0));
+        } else if (consulta == 2 || consulta == 3) {
+            printf("Nome do jogador: ");
+            if (!tecladoLerLinha(entrada, sizeof(entrada))) return;
+            if (consulta == 2) {
+                exibirPartidasDoJogador(entrada);
+            } else {
+                exibirRecordesDoJogador(entrada);
+            }
+        } else if (consulta == 4) {
+            printf("Numero da partida na lista do historico: ");
+            if (!tecladoLerLinha(entrada, sizeof(entrada))) return;
+            Partida partida;
+            if (!obterPartidaPorPosicao((size_t) atol(entrada), &partida)) {
+                printf("Partida inexistente.\n");
+                continue;
+            }
+            reproduzirPartida(&partida);
+            clearScreen();
+            exibirHistorico();
+        } else {
+            printf("Consulta invalida.\n");
+        }
+    }
 }
 
 /**
@@ -56,6 +146,7 @@ void exibirInstrucoes() {
 void exibirMenuPrincipal() {
     int opcao;
     int numDiscos;
+    int numPinos;
 
     // Inicializa o sistema de histórico global ao iniciar o programa
     inicializarHistoricoGlobal();
@@ -72,52 +163,37 @@ void exibirMenuPrincipal() {
         printf("-------------------------------------\n");
         printf("Escolha uma opcao: ");
 
-        // Garante que o buffer de entrada está limpo antes de ler a opção
-        if (scanf("%d", &opcao) != 1) {
+        // Lê a opção (uma linha inteira); o fim da entrada encerra o programa
+        int lido = lerInteiro(&opcao);
+        if (lido < 0) {
+            opcao = 0;
+        } else if (lido == 0) {
             printf("\nEntrada invalida. Digite um numero. Pressione Enter para continuar...");
-            limparBufferEntrada(); // Limpa o buffer após a leitura falha
-            getchar(); // Espera a confirmação do usuário
+            tecladoEsperarEnter(); // Espera a confirmação do usuário
             continue; // Volta ao início do loop
         }
-        limparBufferEntrada(); // Limpa o buffer após a leitura bem-sucedida do número
 
         switch (opcao) {
             case 1:
                 clearScreen();
                 printf("\n--- Iniciar Novo Jogo ---\n");
                 printf("Digite seu nome: ");
-                // fgets lê a linha inteira, incluindo o '\n'
-                if (fgets(nomeJogadorAtual, sizeof(nomeJogadorAtual), stdin) == NULL) {
-                    fprintf(stderr, "Erro ao ler o nome do jogador.\n");
-                    continue;
+                if (!tecladoLerLinha(nomeJogadorAtual, sizeof(nomeJogadorAtual)) ||
+                    !lerNumeroNoIntervalo("Escolha o numero de discos", "discos", MIN_DISCOS, MAX_DISCOS, &numDiscos) ||
+                    !lerNumeroNoIntervalo("Escolha o numero de pinos", "pinos", MIN_PINOS, MAX_PINOS, &numPinos)) {
+                    opcao = 0; // Fim da entrada
+                    break;
                 }
-                // Remove o '\n' lido por fgets, se presente
-                nomeJogadorAtual[strcspn(nomeJogadorAtual, "\n")] = '\0';
-
-                // Loop para garantir que o número de discos seja válido
-                do {
-                    printf("Escolha o numero de discos (%d a %d): ", MIN_DISCOS, MAX_DISCOS);
-                    if (scanf("%d", &numDiscos) != 1) {
-                        printf("Entrada invalida. Digite um numero.\n");
-                        limparBufferEntrada(); // Limpa o buffer após a leitura falha
-                    } else if (numDiscos < MIN_DISCOS || numDiscos > MAX_DISCOS) {
-                        printf("Numero de discos fora do intervalo permitido.\n");
-                    } else {
-                        break; // Sai do loop interno se a entrada for válida
-                    }
-                } while (1);
-                limparBufferEntrada(); // Limpa o buffer após a leitura bem-sucedida do número de discos
 
-                jogar(numDiscos); // Inicia o jogo
+                tecladoAtivarModoBruto(); // Movimentos tecla a tecla, sem Enter
+                jogar(numDiscos, numPinos); // Inicia o jogo
+                tecladoRestaurarModo();
                 break;
             case 2:
                 exibirInstrucoes();
                 break;
             case 3:
-                clearScreen();
-                exibirHistorico();
-                printf("\nPressione Enter para voltar ao menu...");
-                getchar(); // Espera o usuário pressionar Enter
+                exibirTelaHistorico(); // Histórico e consultas de classificação
                 break;
             case 0:
                 clearScreen();
@@ -125,11 +201,13 @@ void exibirMenuPrincipal() {
                 break;
             default:
                 printf("\nOpcao invalida! Pressione Enter para tentar novamente...");
-                getchar(); // Espera o usuário pressionar Enter
+                tecladoEsperarEnter(); // Espera o usuário pressionar Enter
                 break;
         }
     } while (opcao != 0);
 
     // Libera a memória alocada para o histórico global antes de sair do programa
     liberarHistoricoGlobal();
+    liberarTela(); // Libera os buffers da camada de exibição
+    liberarPoolsPilha(); // Libera os blocos de nós e pilhas
 }
\ No newline at end of file
@@ -3,7 +3,11 @@
 
 // Constantes para limites do número de discos
 #define MIN_DISCOS 3
-#define MAX_DISCOS 10
+#define MAX_DISCOS 64 // Um bit por disco no motor bitboard; acima de 10, a tela usa a visão compacta
+
+// Constantes para limites do número de pinos (A, B, C, ... até H)
+#define MIN_PINOS 3
+#define MAX_PINOS 8
 
 // Variável global para armazenar o nome do jogador atual
 // (declarada aqui e definida em menu.c)
@@ -11,8 +15,8 @@ extern char nomeJogadorAtual[50];
 
 // Protótipos das funções do menu
 void clearScreen();
-void limparBufferEntrada();
 void exibirMenuPrincipal();
 void exibirInstrucoes();
+void exibirTelaHistorico();
 
 #endif // MENU_H
\ No newline at end of file
@@ -1,20 +1,56 @@
 #include "pilha.h"
+#include "estado.h" // Para as operações de bits do motor bitboard
+#include "pool.h"   // Para o pool de nós e de pilhas
 #include <stdio.h>
-#include <stdlib.h> // Para malloc e free
+
+// Objetos alocados por vez nos pools (um bloco de nós cobre uma partida inteira)
+#define NOS_POR_BLOCO 256
+#define PILHAS_POR_BLOCO 16
+
+// Motor usado pelas pilhas criadas com criarPilha
+MotorPilha motorPilhaPadrao = MOTOR_BITBOARD;
+
+// Pools de onde saem os nós (discos) e as pilhas: depois do primeiro bloco,
+// empilhar/desempilhar reaproveitam nós devolvidos e não fazem nenhuma alocação.
+static PoolObjetos poolNos;
+static PoolObjetos poolPilhas;
+
+// Inicializa os pools na primeira utilização
+static void prepararPools() {
+    if (poolNos.tamanhoObjeto == 0) {
+        inicializarPool(&poolNos, sizeof(No), NOS_POR_BLOCO);
+        inicializarPool(&poolPilhas, sizeof(Pilha), PILHAS_POR_BLOCO);
+    }
+}
 
 /**
- * @brief Cria e inicializa uma nova pilha (torre).
+ * @brief Cria e inicializa uma nova pilha (torre) usando o motor padrão.
  * @param nome O caractere que identifica a pilha (ex: 'A', 'B', 'C').
  * @return Um ponteiro para a Pilha recém-criada, ou NULL em caso de erro de alocação.
  */
 Pilha* criarPilha(char nome) {
-    Pilha* novaPilha = (Pilha*) malloc(sizeof(Pilha));
+    return criarPilhaComMotor(nome, motorPilhaPadrao);
+}
+
+/**
+ * @brief Cria e inicializa uma nova pilha (torre) com o motor de estado escolhido.
+ * * No MOTOR_BITBOARD a pilha é uma máscara de bits (até 64 discos) e empilhar/desempilhar
+ * * não fazem nenhuma alocação.
+ * @param nome O caractere que identifica a pilha (ex: 'A', 'B', 'C').
+ * @param motor O motor de estado da pilha.
+ * @return Um ponteiro para a Pilha recém-criada, ou NULL em caso de erro de alocação.
+ */
+Pilha* criarPilhaComMotor(char nome, MotorPilha motor) {
+    prepararPools();
+    Pilha* novaPilha = (Pilha*) obterDoPool(&poolPilhas);
     if (novaPilha == NULL) {
         perror("Erro ao alocar memoria para pilha");
         return NULL;
     }
-    novaPilha->topo = NULL; // A pilha começa vazia
-    novaPilha->nome = nome; // Atribui o nome à pilha
+    novaPilha->topo = NULL;   // A pilha começa vazia
+    novaPilha->discos = 0;    // Nenhum bit ligado: nenhum disco
+    novaPilha->motor = motor; // Motor de estado escolhido
+    novaPilha->nome = nome;   // Atribui o nome à pilha
     return novaPilha;
 }
 
@@ -30,9 +66,9 @@ void liberarPilha(Pilha* pilha) {
     while (atual != NULL) {
         No* temp = atual;
         atual = atual->abaixo;
-        free(temp); // Libera cada nó (disco)
+        devolverAoPool(&poolNos, temp); // Devolve cada nó (disco) ao pool
     }
-    free(pilha); // Libera a estrutura da pilha em si
+    devolverAoPool(&poolPilhas, pilha); // Devolve a estrutura da pilha em si
 }
 
 /**
@@ -41,7 +77,13 @@ void liberarPilha(Pilha* pilha) {
  * @return 1 se a pilha estiver vazia, 0 caso contrário.
  */
 int pilhaVazia(Pilha* pilha) {
-    return (pilha == NULL || pilha->topo == NULL);
+    if (pilha == NULL) {
+        return 1;
+    }
+    if (pilha->motor == MOTOR_BITBOARD) {
+        return pilha->discos == 0;
+    }
+    return pilha->topo == NULL;
 }
 
 /**
@@ -57,6 +99,20 @@ void empilhar(Pilha* pilha, int tamanhoDisco) {
         return;
     }
 
+    if (pilha->motor == MOTOR_BITBOARD) {
+        if (tamanhoDisco < 1 || tamanhoDisco > ESTADO_MAX_DISCOS) {
+            fprintf(stderr, "Erro: Tamanho de disco fora do limite do bitboard.\n");
+            return;
+        }
+        // O topo é o bit mais baixo: o novo disco precisa ficar abaixo dele
+        if (pilha->discos != 0 && tamanhoDisco > estadoTopoDoPino(pilha->discos)) {
+            fprintf(stderr, "Erro: Nao pode empilhar disco maior sobre disco menor.\n");
+            return;
+        }
+        pilha->discos |= (uint64_t)1 << (tamanhoDisco - 1);
+        return;
+    }
+
     // Regra da Torre de Hanói: disco maior não pode ir em cima de disco menor
     if (pilha->topo != NULL && tamanhoDisco > pilha->topo->tamanhoDisco) {
         // Isso não deveria acontecer se a validação de movimento estiver correta no main.c,
@@ -65,7 +121,8 @@ void empilhar(Pilha* pilha, int tamanhoDisco) {
         return;
     }
 
-    No* novoNo = (No*) malloc(sizeof(No));
+    prepararPools();
+    No* novoNo = (No*) obterDoPool(&poolNos);
     if (novoNo == NULL) {
         perror("Erro ao alocar memoria para novo disco");
         return;
@@ -85,10 +142,15 @@ int desempilhar(Pilha* pilha) {
         // fprintf(stderr, "Erro: Pilha vazia, nao ha disco para desempilhar.\n"); // Pode ser um erro esperado no fluxo do jogo, então não é um erro fatal
         return -1; // Retorna -1 para indicar que não há disco
     }
+    if (pilha->motor == MOTOR_BITBOARD) {
+        int tamanhoTopo = estadoTopoDoPino(pilha->discos);
+        pilha->discos &= pilha->discos - 1; // Desliga o bit mais baixo (o topo)
+        return tamanhoTopo;
+    }
     No* noRemovido = pilha->topo;       // Guarda o nó a ser removido
     int tamanho = noRemovido->tamanhoDisco; // Pega o tamanho do disco
     pilha->topo = noRemovido->abaixo;  // O topo agora é o próximo nó
-    free(noRemovido);                  // Libera a memória do nó removido
+    devolverAoPool(&poolNos, noRemovido); // Devolve o nó removido ao pool
     return tamanho;                    // Retorna o tamanho do disco
 }
 
@@ -101,5 +163,76 @@ int topoDisco(Pilha* pilha) {
     if (pilhaVazia(pilha)) {
         return -1; // Retorna -1 se a pilha estiver vazia
     }
+    if (pilha->motor == MOTOR_BITBOARD) {
+        return estadoTopoDoPino(pilha->discos);
+    }
     return pilha->topo->tamanhoDisco; // Retorna o tamanho do disco no topo
+}
+
+/**
+ * @brief Retorna quantos discos existem na pilha.
+ * @param pilha O ponteiro para a Pilha.
+ * @return O número de discos (0 se a pilha estiver vazia).
+ */
+int alturaPilha(Pilha* pilha) {
+    if (pilhaVazia(pilha)) {
+        return 0;
+    }
+    if (pilha->motor == MOTOR_BITBOARD) {
+        return ESTADO_CONTAR_BITS(pilha->discos);
+    }
+    int altura = 0;
+    for (No* atual = pilha->topo; atual != NULL; atual = atual->abaixo) {
+        altura++;
+    }
+    return altura;
+}
+
+/**
+ * @brief Copia os discos da pilha para um vetor, da base para o topo.
+ * * Permite percorrer a pilha uma única vez, qualquer que seja o motor.
+ * @param pilha O ponteiro para a Pilha.
+ * @param discos Vetor de saída com espaço para todos os discos da pilha.
+ * @return O número de discos copiados.
+ */
+int discosDaPilha(Pilha* pilha, int* discos) {
+    int altura = alturaPilha(pilha);
+    if (altura == 0) {
+        return 0;
+    }
+    if (pilha->motor == MOTOR_BITBOARD) {
+        // Do bit mais alto (base) para o mais baixo (topo)
+        uint64_t restantes = pilha->discos;
+        for (int i = 0; i < altura; i++) {
+            int bitMaisAlto = ESTADO_BIT_MAIS_ALTO(restantes);
+            discos[i] = bitMaisAlto + 1;
+            restantes &= ~((uint64_t)1 << bitMaisAlto);
+        }
+        return altura;
+    }
+    // A lista vai do topo para a base: preenche o vetor de trás para frente
+    int i = altura - 1;
+    for (No* atual = pilha->topo; atual != NULL; atual = atual->abaixo) {
+        discos[i--] = atual->tamanhoDisco;
+    }
+    return altura;
+}
+
+/**
+ * @brief Copia os contadores de alocação dos pools de nós e de pilhas.
+ * * Permite verificar que os movimentos não fazem alocações (alocacoesSistema não muda).
+ * @param nos Recebe os contadores do pool de nós (pode ser NULL).
+ * @param pilhas Recebe os contadores do pool de pilhas (pode ser NULL).
+ */
+void obterEstatisticasPilha(EstatisticasPool* nos, EstatisticasPool* pilhas) {
+    if (nos != NULL) *nos = poolNos.estatisticas;
+    if (pilhas != NULL) *pilhas = poolPilhas.estatisticas;
+}
+
+/**
+ * @brief Libera a memória dos pools. Só deve ser chamada quando nenhuma pilha estiver em uso.
+ */
+void liberarPoolsPilha() {
+    liberarPool(&poolNos);
+    liberarPool(&poolPilhas);
 }
\ No newline at end of file
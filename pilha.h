@@ -1,6 +1,15 @@
 #ifndef PILHA_H
 #define PILHA_H
 
+#include <stdint.h> // Para uint64_t
+#include "pool.h"   // Para EstatisticasPool
+
+// Motores de estado disponíveis para as pilhas
+typedef enum {
+    MOTOR_LISTA,     // Lista encadeada: um nó alocado por disco
+    MOTOR_BITBOARD   // Máscara de bits: um bit por disco, sem alocação por movimento
+} MotorPilha;
+
 // Estrutura para representar um nó (disco) na pilha
 typedef struct No {
     int tamanhoDisco;   // Tamanho do disco
@@ -9,16 +18,26 @@ typedef struct No {
 
 // Estrutura para representar a pilha (torre)
 typedef struct {
-    No *topo;           // Ponteiro para o disco no topo da pilha
+    No *topo;           // Ponteiro para o disco no topo da pilha (MOTOR_LISTA)
+    uint64_t discos;    // Bit (d - 1) ligado se o disco d está na pilha (MOTOR_BITBOARD)
+    MotorPilha motor;   // Motor usado por esta pilha
     char nome;          // Nome da torre (ex: 'A', 'B', 'C')
 } Pilha;
 
+// Motor usado por criarPilha (definido em pilha.c, MOTOR_BITBOARD por padrão)
+extern MotorPilha motorPilhaPadrao;
+
 // Protótipos das funções da Pilha
 Pilha* criarPilha(char nome);
+Pilha* criarPilhaComMotor(char nome, MotorPilha motor);
 void liberarPilha(Pilha* pilha);
 int pilhaVazia(Pilha* pilha);
 void empilhar(Pilha* pilha, int tamanhoDisco);
 int desempilhar(Pilha* pilha);
 int topoDisco(Pilha* pilha);
+int alturaPilha(Pilha* pilha);
+int discosDaPilha(Pilha* pilha, int* discos);
+void obterEstatisticasPilha(EstatisticasPool* nos, EstatisticasPool* pilhas);
+void liberarPoolsPilha();
 
-#endif // PILHA_H
\ No newline at end of file
+#endif // PILHA_H
@@ -0,0 +1,91 @@
+#include "pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Alinhamento dos objetos dentro de um bloco
+#define ALINHAMENTO_POOL sizeof(void*)
+
+/**
+ * @brief Prepara um pool vazio; nenhuma memória é alocada até o primeiro obterDoPool.
+ * @param pool O pool a ser inicializado.
+ * @param tamanhoObjeto O tamanho (sizeof) dos objetos do pool.
+ * @param objetosPorBloco Quantos objetos alocar a cada vez que o pool esvaziar.
+ */
+void inicializarPool(PoolObjetos* pool, size_t tamanhoObjeto, size_t objetosPorBloco) {
+    memset(pool, 0, sizeof(PoolObjetos));
+    if (tamanhoObjeto < sizeof(void*)) {
+        tamanhoObjeto = sizeof(void*); // O objeto livre precisa guardar o ponteiro da lista
+    }
+    pool->tamanhoObjeto = (tamanhoObjeto + ALINHAMENTO_POOL - 1) / ALINHAMENTO_POOL * ALINHAMENTO_POOL;
+    pool->objetosPorBloco = (objetosPorBloco > 0) ? objetosPorBloco : 1;
+}
+
+// Aloca um novo bloco e coloca todos os seus objetos na lista livre
+static int crescerPool(PoolObjetos* pool) {
+    // O início do bloco guarda o ponteiro para o bloco anterior
+    size_t cabecalho = (sizeof(void*) + ALINHAMENTO_POOL - 1) / ALINHAMENTO_POOL * ALINHAMENTO_POOL;
+    char* bloco = (char*) malloc(cabecalho + pool->tamanhoObjeto * pool->objetosPorBloco);
+    if (bloco == NULL) {
+        return 0;
+    }
+    pool->estatisticas.alocacoesSistema++;
+    *(void**) bloco = pool->blocos;
+    pool->blocos = bloco;
+
+    char* objeto = bloco + cabecalho;
+    for (size_t i = 0; i < pool->objetosPorBloco; i++, objeto += pool->tamanhoObjeto) {
+        *(void**) objeto = pool->livres;
+        pool->livres = objeto;
+    }
+    return 1;
+}
+
+/**
+ * @brief Retira um objeto do pool (equivalente a malloc(tamanhoObjeto)).
+ * * Só chama malloc quando a lista livre está vazia, e então aloca um bloco inteiro.
+ * @return Um ponteiro para o objeto, ou NULL em caso de erro de alocação.
+ */
+void* obterDoPool(PoolObjetos* pool) {
+    if (pool->livres == NULL && !crescerPool(pool)) {
+        return NULL;
+    }
+    void* objeto = pool->livres;
+    pool->livres = *(void**) objeto;
+    pool->estatisticas.obtidos++;
+    pool->estatisticas.emUso++;
+    return objeto;
+}
+
+/**
+ * @brief Devolve um objeto ao pool (equivalente a free); a memória fica disponível para reuso.
+ */
+void devolverAoPool(PoolObjetos* pool, void* objeto) {
+    if (objeto == NULL) {
+        return;
+    }
+    *(void**) objeto = pool->livres;
+    pool->livres = objeto;
+    pool->estatisticas.devolvidos++;
+    pool->estatisticas.emUso--;
+}
+
+/**
+ * @brief Libera todos os blocos do pool. Os objetos ainda em uso deixam de ser válidos.
+ */
+void liberarPool(PoolObjetos* pool) {
+    void* bloco = pool->blocos;
+    while (bloco != NULL) {
+        void* anterior = *(void**) bloco;
+        free(bloco);
+        bloco = anterior;
+    }
+    size_t tamanhoObjeto = pool->tamanhoObjeto;
+    size_t objetosPorBloco = pool->objetosPorBloco;
+    EstatisticasPool estatisticas = pool->estatisticas; // Os contadores são acumulados até o fim do programa
+    memset(pool, 0, sizeof(PoolObjetos));
+    pool->tamanhoObjeto = tamanhoObjeto;
+    pool->objetosPorBloco = objetosPorBloco;
+    pool->estatisticas = estatisticas;
+    pool->estatisticas.emUso = 0;
+}
@@ -0,0 +1,30 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h> // Para size_t
+
+// Contadores de uso de um pool de objetos
+typedef struct {
+    size_t alocacoesSistema; // Blocos pedidos ao malloc
+    size_t obtidos;          // Objetos entregues por obterDoPool
+    size_t devolvidos;       // Objetos devolvidos por devolverAoPool
+    size_t emUso;            // Objetos entregues e ainda não devolvidos
+} EstatisticasPool;
+
+// Pool de objetos de tamanho fixo: aloca blocos com vários objetos e reaproveita
+// os objetos devolvidos por meio de uma lista livre, sem chamar malloc/free a cada uso.
+typedef struct {
+    size_t tamanhoObjeto;        // Tamanho de cada objeto (ajustado para caber um ponteiro)
+    size_t objetosPorBloco;      // Objetos alocados de uma vez quando a lista livre esvazia
+    void* livres;                // Lista livre: cada objeto livre guarda o endereço do próximo
+    void* blocos;                // Blocos alocados (encadeados pelo primeiro ponteiro)
+    EstatisticasPool estatisticas;
+} PoolObjetos;
+
+// Protótipos das funções do pool
+void inicializarPool(PoolObjetos* pool, size_t tamanhoObjeto, size_t objetosPorBloco);
+void* obterDoPool(PoolObjetos* pool);
+void devolverAoPool(PoolObjetos* pool, void* objeto);
+void liberarPool(PoolObjetos* pool);
+
+#endif // POOL_H
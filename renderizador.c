@@ -0,0 +1,347 @@
+#include "renderizador.h"
+#include "estado.h"
+#include "solucionador.h"
+#include "cronometro.h"
+#include <stdarg.h> // Para va_list em anexarAoQuadro
+#include <stdlib.h>
+#include <string.h>
+
+// Espaço entre os pinos na tela
+#define ESPACO_ENTRE_PINOS "   "
+#define TAMANHO_ESPACO_ENTRE_PINOS 3
+
+// Espaço reservado para o título do quadro
+#define TAMANHO_MAXIMO_TITULO 64
+
+// Espaço reservado para linhas anexadas depois das torres (ex: contador de movimentos)
+#define TAMANHO_MAXIMO_RODAPE 256
+
+// Pinos usados no benchmark (a solução ótima de referência é a de 3 pinos)
+#define PINOS_BENCHMARK 3
+
+// Movimentos aplicados no máximo para preparar a posição do benchmark (a metade de 2^n - 1 não cabe em tempo para n grande)
+#define MOVIMENTOS_MAXIMOS_PREPARACAO (1u << 20)
+
+// Largura de um pino na visão compacta (a do maior disco da visão detalhada)
+#define LARGURA_PINO_COMPACTO (2 * RENDERIZADOR_MAX_DISCOS_DETALHADO - 1)
+
+// Uma linha da visão compacta: os discos de 'menor' a 'maior' de um pino
+typedef struct {
+    int menor;
+    int maior;
+    int consecutivos; // 0 se a faixa agrupa discos não consecutivos (as de baixo, além do limite de linhas)
+} FaixaDiscos;
+
+#ifdef _WIN32
+#define CAMINHO_SAIDA_NULA "NUL"
+#else
+#define CAMINHO_SAIDA_NULA "/dev/null"
+#endif
+
+/**
+ * @brief Calcula quantos bytes um quadro pode ocupar no pior caso.
+ * * Cada linha tem, por pino, a largura do maior disco (2n - 1) mais a base "---"
+ * * e o espaço entre pinos; são n linhas de discos, a linha da base e a dos nomes.
+ * * A visão compacta nunca passa do tamanho do quadro detalhado mais largo.
+ */
+static size_t capacidadeNecessaria(int maxDiscos, int maxPinos) {
+    if (maxDiscos > RENDERIZADOR_MAX_DISCOS_DETALHADO) {
+        maxDiscos = RENDERIZADOR_MAX_DISCOS_DETALHADO;
+    }
+    size_t larguraPino = (size_t)(2 * maxDiscos - 1) + 2 + TAMANHO_ESPACO_ENTRE_PINOS;
+    size_t larguraLinha = (size_t)maxPinos * larguraPino + 1; // +1 para o '\n'
+    return TAMANHO_MAXIMO_TITULO + (size_t)(maxDiscos + 2) * larguraLinha + TAMANHO_MAXIMO_RODAPE;
+}
+
+/**
+ * @brief Aloca o buffer de quadro para o maior jogo que será exibido.
+ * * A alocação é feita uma única vez; os quadros seguintes reaproveitam o buffer.
+ * @param quadro O quadro a ser inicializado.
+ * @param maxDiscos O maior número de discos que será desenhado.
+ * @param maxPinos O maior número de pinos que será desenhado.
+ * @return 1 em caso de sucesso, 0 em caso de erro de alocação.
+ */
+int inicializarQuadro(QuadroTela* quadro, int maxDiscos, int maxPinos) {
+    memset(quadro, 0, sizeof(QuadroTela));
+    quadro->capacidade = capacidadeNecessaria(maxDiscos, maxPinos);
+    quadro->dados = (char*) malloc(quadro->capacidade);
+    if (quadro->dados == NULL) {
+        perror("Erro ao alocar memoria para o quadro da tela");
+        quadro->capacidade = 0;
+        return 0;
+    }
+    quadro->maxDiscos = maxDiscos;
+    quadro->maxPinos = maxPinos;
+    return 1;
+}
+
+/**
+ * @brief Libera o buffer de quadro.
+ */
+void liberarQuadro(QuadroTela* quadro) {
+    free(quadro->dados);
+    memset(quadro, 0, sizeof(QuadroTela));
+}
+
+// Escreve 'quantidade' cópias de 'c' no cursor e o avança
+static inline char* preencher(char* cursor, char c, int quantidade) {
+    memset(cursor, c, (size_t)quantidade);
+    return cursor + quantidade;
+}
+
+// Escreve um disco (ou a haste, se tamanho 0) centralizado na largura do pino
+static inline char* escreverDisco(char* cursor, int tamanho, int larguraMax) {
+    int larguraDisco = (tamanho == 0) ? 1 : (2 * tamanho - 1);
+    int espacosLaterais = (larguraMax - larguraDisco) / 2;
+    cursor = preencher(cursor, ' ', espacosLaterais);
+    cursor = (tamanho == 0) ? preencher(cursor, '|', 1) : preencher(cursor, '=', larguraDisco);
+    cursor = preencher(cursor, ' ', espacosLaterais);
+    memcpy(cursor, ESPACO_ENTRE_PINOS, TAMANHO_ESPACO_ENTRE_PINOS);
+    return cursor + TAMANHO_ESPACO_ENTRE_PINOS;
+}
+
+// Agrupa os discos de um pino (da base ao topo) em faixas de tamanhos consecutivos.
+// Se houver mais faixas que RENDERIZADOR_LINHAS_COMPACTAS, as de baixo viram uma só.
+// Retorna o número de faixas, da base (índice 0) ao topo.
+static int faixasDoPino(const int* discos, int altura, FaixaDiscos* faixas) {
+    int numFaixas = 0;
+    for (int i = 0; i < altura; i++) {
+        if (numFaixas > 0 && faixas[numFaixas - 1].menor == discos[i] + 1) {
+            faixas[numFaixas - 1].menor = discos[i];
+        } else {
+            faixas[numFaixas].menor = discos[i];
+            faixas[numFaixas].maior = discos[i];
+            faixas[numFaixas].consecutivos = 1;
+            numFaixas++;
+        }
+    }
+    if (numFaixas > RENDERIZADOR_LINHAS_COMPACTAS) {
+        int agrupadas = numFaixas - RENDERIZADOR_LINHAS_COMPACTAS + 1;
+        faixas[0].menor = faixas[agrupadas - 1].menor;
+        faixas[0].consecutivos = 0;
+        memmove(&faixas[1], &faixas[agrupadas], (size_t)(numFaixas - agrupadas) * sizeof(FaixaDiscos));
+        numFaixas = RENDERIZADOR_LINHAS_COMPACTAS;
+    }
+    return numFaixas;
+}
+
+// Escreve uma faixa da visão compacta: uma barra com a largura do maior disco em escala
+// e o intervalo de discos no meio ("7", "3-9" ou, para faixas agrupadas, "1..40")
+static char* escreverFaixa(char* cursor, const FaixaDiscos* faixa, int totalDiscos) {
+    char rotulo[16];
+    int tamanhoRotulo = (faixa->menor == faixa->maior)
+                        ? snprintf(rotulo, sizeof(rotulo), "%d", faixa->menor)
+                        : snprintf(rotulo, sizeof(rotulo), faixa->consecutivos ? "%d-%d" : "%d..%d",
+                                   faixa->menor, faixa->maior);
+    // Largura ímpar de 3 a LARGURA_PINO_COMPACTO, proporcional ao maior disco, mas sempre com o rótulo visível
+    int largura = 1 + 2 * ((faixa->maior * (RENDERIZADOR_MAX_DISCOS_DETALHADO - 1) + totalDiscos - 1) / totalDiscos);
+    int larguraMinima = tamanhoRotulo + 2 + (tamanhoRotulo % 2 == 0);
+    if (largura < larguraMinima) {
+        largura = larguraMinima;
+    }
+    int espacosLaterais = (LARGURA_PINO_COMPACTO - largura) / 2;
+    int barraEsquerda = (largura - tamanhoRotulo) / 2;
+    cursor = preencher(cursor, ' ', espacosLaterais);
+    cursor = preencher(cursor, '=', barraEsquerda);
+    memcpy(cursor, rotulo, (size_t) tamanhoRotulo);
+    cursor += tamanhoRotulo;
+    cursor = preencher(cursor, '=', largura - tamanhoRotulo - barraEsquerda);
+    cursor = preencher(cursor, ' ', espacosLaterais);
+    memcpy(cursor, ESPACO_ENTRE_PINOS, TAMANHO_ESPACO_ENTRE_PINOS);
+    return cursor + TAMANHO_ESPACO_ENTRE_PINOS;
+}
+
+// Monta os níveis da visão compacta: no máximo RENDERIZADOR_LINHAS_COMPACTAS linhas de largura fixa
+static char* escreverNiveisCompactos(char* cursor, int discosPorPino[][ESTADO_MAX_DISCOS], const int* alturaPorPino,
+                                     int numPinos, int totalDiscos) {
+    FaixaDiscos faixas[ESTADO_MAX_PINOS][ESTADO_MAX_DISCOS];
+    int numFaixas[ESTADO_MAX_PINOS];
+    int niveis = 1; // Pelo menos uma linha de hastes
+    for (int i = 0; i < numPinos; i++) {
+        numFaixas[i] = faixasDoPino(discosPorPino[i], alturaPorPino[i], faixas[i]);
+        if (numFaixas[i] > niveis) niveis = numFaixas[i];
+    }
+    for (int nivelAtual = niveis - 1; nivelAtual >= 0; nivelAtual--) {
+        for (int i = 0; i < numPinos; i++) {
+            cursor = (nivelAtual < numFaixas[i]) ? escreverFaixa(cursor, &faixas[i][nivelAtual], totalDiscos)
+                                                 : escreverDisco(cursor, 0, LARGURA_PINO_COMPACTO);
+        }
+        *cursor++ = '\n';
+    }
+    return cursor;
+}
+
+/**
+ * @brief Monta no buffer o quadro completo das torres (título, discos, base e nomes).
+ * * Cada pino é lido uma única vez e cada byte do quadro é escrito uma única vez,
+ * * então o custo é linear no tamanho da saída.
+ * * Acima de RENDERIZADOR_MAX_DISCOS_DETALHADO discos, usa a visão compacta: cada linha
+ * * é uma faixa de discos consecutivos, com largura em escala e o intervalo escrito na
+ * * barra, e cada pino ocupa no máximo RENDERIZADOR_LINHAS_COMPACTAS linhas. Assim o
+ * * tamanho do quadro e o tempo para montá-lo não crescem com o número de discos.
+ * @param quadro O buffer de quadro (já inicializado com capacidade suficiente).
+ * @param pinos Os pinos do jogo.
+ * @param numPinos Quantos pinos desenhar.
+ * @param totalDiscos O número total de discos da partida.
+ */
+void montarQuadroTorres(QuadroTela* quadro, Pilha* pinos[], int numPinos, int totalDiscos) {
+    quadro->tamanho = 0;
+    if (totalDiscos > quadro->maxDiscos || numPinos > quadro->maxPinos || numPinos > ESTADO_MAX_PINOS) {
+        return; // Capacidade insuficiente: quadro vazio
+    }
+
+    int discosPorPino[ESTADO_MAX_PINOS][ESTADO_MAX_DISCOS];
+    int alturaPorPino[ESTADO_MAX_PINOS];
+    for (int i = 0; i < numPinos; i++) {
+        alturaPorPino[i] = discosDaPilha(pinos[i], discosPorPino[i]);
+    }
+
+    char* cursor = quadro->dados;
+    int compacta = totalDiscos > RENDERIZADOR_MAX_DISCOS_DETALHADO;
+    cursor += snprintf(cursor, TAMANHO_MAXIMO_TITULO, compacta ? "\nTorre de Hanoi - %d discos (visao compacta)\n\n"
+                                                               : "\nTorre de Hanoi - %d discos\n\n", totalDiscos);
+
+    int larguraMaximaPino = compacta ? LARGURA_PINO_COMPACTO : 2 * totalDiscos - 1;
+
+    if (compacta) {
+        cursor = escreverNiveisCompactos(cursor, discosPorPino, alturaPorPino, numPinos, totalDiscos);
+    } else {
+        // Níveis dos pinos, do topo para a base
+        for (int nivelAtual = totalDiscos - 1; nivelAtual >= 0; nivelAtual--) {
+            for (int i = 0; i < numPinos; i++) {
+                int disco = (nivelAtual < alturaPorPino[i]) ? discosPorPino[i][nivelAtual] : 0;
+                cursor = escreverDisco(cursor, disco, larguraMaximaPino);
+            }
+            *cursor++ = '\n';
+        }
+    }
+
+    // Base dos pinos ("---") e nomes, centralizados
+    for (int i = 0; i < numPinos; i++) {
+        cursor = preencher(cursor, ' ', larguraMaximaPino / 2);
+        cursor = preencher(cursor, '-', 3);
+        cursor = preencher(cursor, ' ', larguraMaximaPino / 2 + TAMANHO_ESPACO_ENTRE_PINOS);
+    }
+    *cursor++ = '\n';
+    for (int i = 0; i < numPinos; i++) {
+        cursor = preencher(cursor, ' ', larguraMaximaPino / 2);
+        *cursor++ = pinos[i]->nome;
+        cursor = preencher(cursor, ' ', larguraMaximaPino / 2 + TAMANHO_ESPACO_ENTRE_PINOS);
+    }
+    *cursor++ = '\n';
+
+    quadro->tamanho = (size_t)(cursor - quadro->dados);
+}
+
+/**
+ * @brief Acrescenta texto formatado (como printf) ao fim do quadro montado.
+ * * O texto é truncado se não couber no espaço reservado para o rodapé.
+ */
+void anexarAoQuadro(QuadroTela* quadro, const char* formato, ...) {
+    if (quadro->dados == NULL || quadro->tamanho >= quadro->capacidade) {
+        return;
+    }
+    size_t disponivel = quadro->capacidade - quadro->tamanho;
+    va_list argumentos;
+    va_start(argumentos, formato);
+    int escritos = vsnprintf(quadro->dados + quadro->tamanho, disponivel, formato, argumentos);
+    va_end(argumentos);
+    if (escritos > 0) {
+        quadro->tamanho += ((size_t)escritos < disponivel) ? (size_t)escritos : disponivel - 1;
+    }
+}
+
+/**
+ * @brief Envia o quadro montado com uma única escrita.
+ */
+void enviarQuadro(QuadroTela* quadro, FILE* saida) {
+    fwrite(quadro->dados, 1, quadro->tamanho, saida);
+    fflush(saida);
+}
+
+// Renderizador antigo (um printf por caractere), mantido apenas como referência no benchmark
+static void renderizarPorCaractere(FILE* saida, Pilha* pinos[], int numPinos, int totalDiscos) {
+    int larguraMaximaPino = 2 * totalDiscos - 1;
+    fprintf(saida, "\nTorre de Hanoi - %d discos\n\n", totalDiscos);
+    for (int nivelAtual = totalDiscos - 1; nivelAtual >= 0; nivelAtual--) {
+        for (int i = 0; i < numPinos; i++) {
+            // Percorre a pilha a cada nível, como a versão original
+            int discos[ESTADO_MAX_DISCOS];
+            int altura = discosDaPilha(pinos[i], discos);
+            int tamanho = (nivelAtual < altura) ? discos[nivelAtual] : 0;
+            int larguraDisco = (tamanho == 0) ? 1 : (2 * tamanho - 1);
+            int espacosLaterais = (larguraMaximaPino - larguraDisco) / 2;
+            for (int j = 0; j < espacosLaterais; j++) fprintf(saida, " ");
+            if (tamanho == 0) {
+                fprintf(saida, "|");
+            } else {
+                for (int j = 0; j < larguraDisco; j++) fprintf(saida, "=");
+            }
+            for (int j = 0; j < espacosLaterais; j++) fprintf(saida, " ");
+            fprintf(saida, ESPACO_ENTRE_PINOS);
+        }
+        fprintf(saida, "\n");
+    }
+    fflush(saida);
+}
+
+/**
+ * @brief Mede o tempo por quadro do renderizador, escrevendo em uma saída nula.
+ * * As torres são colocadas no meio da solução ótima (ou após MOVIMENTOS_MAXIMOS_PREPARACAO
+ * * movimentos, com muitos discos) para que todos os pinos tenham discos.
+ * @param numDiscos O número de discos (1 a ESTADO_MAX_DISCOS).
+ * @param numQuadros Quantos quadros desenhar em cada medição.
+ * @return 0 em caso de sucesso, 1 em caso de erro.
+ */
+int executarBenchmarkRenderizacao(int numDiscos, int numQuadros) {
+    if (numDiscos < 1 || numDiscos > ESTADO_MAX_DISCOS || numQuadros < 1) {
+        fprintf(stderr, "Erro: parametros invalidos para o benchmark de renderizacao.\n");
+        return 1;
+    }
+    FILE* saidaNula = fopen(CAMINHO_SAIDA_NULA, "wb");
+    if (saidaNula == NULL) {
+        perror("Erro ao abrir a saida nula");
+        return 1;
+    }
+
+    Pilha* pinos[PINOS_BENCHMARK];
+    pinos[0] = criarPilhaComMotor('A', MOTOR_BITBOARD);
+    pinos[1] = criarPilhaComMotor('B', MOTOR_BITBOARD);
+    pinos[2] = criarPilhaComMotor('C', MOTOR_BITBOARD);
+    QuadroTela quadro;
+    if (pinos[0] == NULL || pinos[1] == NULL || pinos[2] == NULL ||
+        !inicializarQuadro(&quadro, numDiscos, PINOS_BENCHMARK)) {
+        for (int i = 0; i < PINOS_BENCHMARK; i++) liberarPilha(pinos[i]);
+        fclose(saidaNula);
+        return 1;
+    }
+    for (int i = numDiscos; i >= 1; i--) {
+        empilhar(pinos[0], i);
+    }
+    uint64_t preparacao = totalMovimentosOtimos(numDiscos) / 2;
+    resolverSobrePilhas(pinos, numDiscos, preparacao < MOVIMENTOS_MAXIMOS_PREPARACAO ? preparacao
+                                                                                    : MOVIMENTOS_MAXIMOS_PREPARACAO);
+
+    double inicio = cronometroSegundos();
+    for (int q = 0; q < numQuadros; q++) {
+        montarQuadroTorres(&quadro, pinos, PINOS_BENCHMARK, numDiscos);
+        enviarQuadro(&quadro, saidaNula);
+    }
+    double porQuadroBuffer = (cronometroSegundos() - inicio) / numQuadros;
+
+    inicio = cronometroSegundos();
+    for (int q = 0; q < numQuadros; q++) {
+        renderizarPorCaractere(saidaNula, pinos, PINOS_BENCHMARK, numDiscos);
+    }
+    double porQuadroCaractere = (cronometroSegundos() - inicio) / numQuadros;
+
+    printf("Benchmark de renderizacao: %d discos, %d quadros, %zu bytes por quadro\n",
+           numDiscos, numQuadros, quadro.tamanho);
+    printf("%-22s %12.0f ns/quadro\n", "buffer de quadro", porQuadroBuffer * 1e9);
+    printf("%-22s %12.0f ns/quadro\n", "printf por caractere", porQuadroCaractere * 1e9);
+
+    liberarQuadro(&quadro);
+    for (int i = 0; i < PINOS_BENCHMARK; i++) liberarPilha(pinos[i]);
+    fclose(saidaNula);
+    return 0;
+}
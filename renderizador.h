@@ -0,0 +1,33 @@
+#ifndef RENDERIZADOR_H
+#define RENDERIZADOR_H
+
+#include <stdio.h>  // Para FILE
+#include <stddef.h> // Para size_t
+#include "pilha.h"
+
+// Até este número de discos cada disco ocupa uma linha e tem largura 2n - 1;
+// acima dele, o quadro usa a visão compacta (faixas de discos consecutivos em escala)
+#define RENDERIZADOR_MAX_DISCOS_DETALHADO 10
+
+// Linhas por pino na visão compacta; as faixas de baixo que passarem disso são agrupadas em uma
+#define RENDERIZADOR_LINHAS_COMPACTAS 10
+
+// Buffer de quadro: a tela inteira é montada aqui e enviada com uma única escrita
+typedef struct {
+    char* dados;                 // Conteúdo do quadro
+    size_t capacidade;           // Bytes alocados
+    size_t tamanho;              // Bytes usados pelo último quadro
+    int maxDiscos;               // Maior número de discos suportado pela capacidade
+    int maxPinos;                // Maior número de pinos suportado pela capacidade
+    double segundosUltimoQuadro; // Tempo gasto para montar e enviar o último quadro
+} QuadroTela;
+
+// Protótipos das funções do renderizador
+int inicializarQuadro(QuadroTela* quadro, int maxDiscos, int maxPinos);
+void liberarQuadro(QuadroTela* quadro);
+void montarQuadroTorres(QuadroTela* quadro, Pilha* pinos[], int numPinos, int totalDiscos);
+void anexarAoQuadro(QuadroTela* quadro, const char* formato, ...);
+void enviarQuadro(QuadroTela* quadro, FILE* saida);
+int executarBenchmarkRenderizacao(int numDiscos, int numQuadros);
+
+#endif // RENDERIZADOR_H
@@ -0,0 +1,212 @@
+#include "reproducao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "pilha.h"      // Pinos usados para desenhar a posição
+#include "jogo.h"       // Para exibirTorres
+#include "cronometro.h" // Para a espera entre quadros
+#include "teclado.h"    // Para ler os comandos da reprodução
+
+// Aplica o movimento de número 'indice' da gravação ao estado; retorna 0 se ele for inválido
+static int aplicarMovimentoGravado(EstadoTorres* estado, const HistoricoMovimentos* gravacao, size_t indice) {
+    int origem, destino;
+    decodificarMovimento(gravacao->movimentos, gravacao->numPinos, indice, &origem, &destino);
+    return estadoMover(estado, origem, destino) != -1;
+}
+
+// Guarda a posição atual como o ponto de controle de número 'ponto'
+static void guardarPontoDeControle(Reproducao* reproducao, size_t ponto) {
+    memcpy(&reproducao->pontosDeControle[ponto * (size_t) reproducao->estado.numPinos],
+           reproducao->estado.pinos, (size_t) reproducao->estado.numPinos * sizeof(uint64_t));
+}
+
+/**
+ * @brief Prepara a reprodução de uma partida gravada, a partir da posição inicial.
+ * * Percorre a gravação uma vez, guardando a posição (numPinos máscaras de bits) a cada
+ * * 'intervalo' movimentos. Depois disso, ir para qualquer movimento custa um acesso
+ * * direto ao ponto de controle anterior e no máximo 'intervalo' movimentos reaplicados.
+ * * A gravação para no primeiro movimento inválido, se houver (arquivo corrompido).
+ * @param reproducao A reprodução a ser preparada.
+ * @param gravacao Os movimentos da partida (devem continuar válidos durante a reprodução).
+ * @param numDiscos O número de discos da partida.
+ * @param intervalo Movimentos entre pontos de controle (0 usa REPRODUCAO_INTERVALO_PADRAO).
+ * @return 1 em caso de sucesso, 0 em caso de erro de alocação ou parâmetros inválidos.
+ */
+int iniciarReproducao(Reproducao* reproducao, const HistoricoMovimentos* gravacao, int numDiscos, size_t intervalo) {
+    memset(reproducao, 0, sizeof(Reproducao));
+    if (gravacao == NULL || gravacao->movimentos == NULL || gravacao->numMovimentos < 0 ||
+        gravacao->numPinos < ESTADO_MIN_PINOS || gravacao->numPinos > ESTADO_MAX_PINOS ||
+        numDiscos < 1 || numDiscos > ESTADO_MAX_DISCOS) {
+        return 0;
+    }
+    reproducao->gravacao = gravacao;
+    reproducao->intervalo = (intervalo > 0) ? intervalo : REPRODUCAO_INTERVALO_PADRAO;
+    size_t total = (size_t) gravacao->numMovimentos;
+    reproducao->numPontosDeControle = total / reproducao->intervalo + 1;
+    reproducao->pontosDeControle = (uint64_t*) malloc(reproducao->numPontosDeControle *
+                                                      (size_t) gravacao->numPinos * sizeof(uint64_t));
+    if (reproducao->pontosDeControle == NULL) {
+        perror("Erro ao alocar memoria para os pontos de controle da reproducao");
+        return 0;
+    }
+
+    inicializarEstado(&reproducao->estado, numDiscos, gravacao->numPinos, 0);
+    guardarPontoDeControle(reproducao, 0);
+    size_t aplicados = 0;
+    while (aplicados < total && aplicarMovimentoGravado(&reproducao->estado, gravacao, aplicados)) {
+        aplicados++;
+        if (aplicados % reproducao->intervalo == 0) {
+            guardarPontoDeControle(reproducao, aplicados / reproducao->intervalo);
+        }
+    }
+    if (aplicados < total) {
+        fprintf(stderr, "Aviso: movimento %zu da gravacao e invalido; reproducao limitada a %zu movimentos.\n",
+                aplicados + 1, aplicados);
+    }
+    reproducao->totalMovimentos = aplicados;
+    reproducao->numPontosDeControle = aplicados / reproducao->intervalo + 1;
+
+    // Volta para a posição inicial
+    memcpy(reproducao->estado.pinos, reproducao->pontosDeControle,
+           (size_t) gravacao->numPinos * sizeof(uint64_t));
+    reproducao->posicao = 0;
+    return 1;
+}
+
+/**
+ * @brief Aplica o próximo movimento da gravação.
+ * @return 1 se um movimento foi aplicado, 0 se a reprodução já está no fim.
+ */
+int avancarReproducao(Reproducao* reproducao) {
+    if (reproducao->posicao >= reproducao->totalMovimentos) {
+        return 0;
+    }
+    aplicarMovimentoGravado(&reproducao->estado, reproducao->gravacao, reproducao->posicao);
+    reproducao->posicao++;
+    return 1;
+}
+
+/**
+ * @brief Leva a reprodução à posição depois de 'indice' movimentos (0 é a posição inicial).
+ * * Para frente e perto da posição atual, apenas avança; caso contrário, parte do ponto
+ * * de controle anterior a 'indice'. Em ambos os casos, no máximo 'intervalo' movimentos.
+ * @return 1 em caso de sucesso, 0 se 'indice' passa do fim da gravação.
+ */
+int irParaMovimento(Reproducao* reproducao, size_t indice) {
+    if (indice > reproducao->totalMovimentos) {
+        return 0;
+    }
+    size_t ponto = indice / reproducao->intervalo;
+    size_t inicioDoPonto = ponto * reproducao->intervalo;
+    if (indice < reproducao->posicao || reproducao->posicao < inicioDoPonto) {
+        memcpy(reproducao->estado.pinos, &reproducao->pontosDeControle[ponto * (size_t) reproducao->estado.numPinos],
+               (size_t) reproducao->estado.numPinos * sizeof(uint64_t));
+        reproducao->posicao = inicioDoPonto;
+    }
+    while (reproducao->posicao < indice) {
+        avancarReproducao(reproducao);
+    }
+    return 1;
+}
+
+/**
+ * @brief Libera os pontos de controle de uma reprodução (a gravação não é liberada).
+ */
+void liberarReproducao(Reproducao* reproducao) {
+    free(reproducao->pontosDeControle);
+    reproducao->pontosDeControle = NULL;
+    reproducao->numPontosDeControle = 0;
+}
+
+// Desenha a posição atual pelo mesmo renderizador do jogo e mostra o último movimento
+static void exibirReproducao(const Reproducao* reproducao, Pilha* pinos[]) {
+    int numPinos = reproducao->estado.numPinos;
+    for (int i = 0; i < numPinos; i++) {
+        pinos[i]->discos = reproducao->estado.pinos[i]; // Pinos no motor bitboard: cópia direta da máscara
+    }
+    exibirTorres(pinos, numPinos, reproducao->estado.numDiscos, (int) reproducao->posicao);
+    printf("Movimento %zu de %zu", reproducao->posicao, reproducao->totalMovimentos);
+    if (reproducao->posicao > 0) {
+        int origem, destino;
+        decodificarMovimento(reproducao->gravacao->movimentos, numPinos, reproducao->posicao - 1, &origem, &destino);
+        printf(" (ultimo: %c%c)", 'A' + origem, 'A' + destino);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Reproduz uma partida gravada na tela, com avanço manual ou automático.
+ * * Comandos: Enter avança um movimento; 'A' volta um; 'P' reproduz até o fim;
+ * * 'V ms' define o tempo entre quadros; 'G n' vai direto ao movimento n; 'Q' sai.
+ * @param partida A partida a ser reproduzida (precisa ter os movimentos gravados).
+ */
+void reproduzirPartida(const Partida* partida) {
+    if (partida->deslocamentoMovimentos == SEM_MOVIMENTOS) {
+        printf("Esta partida nao tem os movimentos gravados (registrada antes da gravacao de movimentos).\n");
+        return;
+    }
+    HistoricoMovimentos* gravacao = lerMovimentosDaPartida(partida);
+    if (gravacao == NULL) {
+        printf("Nao foi possivel ler os movimentos desta partida.\n");
+        return;
+    }
+    Reproducao reproducao;
+    Pilha* pinos[ESTADO_MAX_PINOS] = {NULL};
+    int pinosCriados = 1;
+    for (int i = 0; i < partida->numPinos; i++) {
+        pinos[i] = criarPilhaComMotor((char)('A' + i), MOTOR_BITBOARD);
+        if (pinos[i] == NULL) pinosCriados = 0;
+    }
+    if (!pinosCriados || !iniciarReproducao(&reproducao, gravacao, partida->numDiscos, REPRODUCAO_INTERVALO_PADRAO)) {
+        fprintf(stderr, "Erro: Nao foi possivel preparar a reproducao.\n");
+        for (int i = 0; i < partida->numPinos; i++) {
+            if (pinos[i] != NULL) liberarPilha(pinos[i]);
+        }
+        liberarHistoricoMovimentos(gravacao);
+        return;
+    }
+
+    int milissegundos = REPRODUCAO_MILISSEGUNDOS_PADRAO;
+    char entrada[50];
+    printf("\nReproducao: %s, %d discos, %d pinos, %d movimentos\n",
+           partida->nomeJogador, partida->numDiscos, partida->numPinos, partida->numMovimentos);
+    while (1) {
+        exibirReproducao(&reproducao, pinos);
+        printf("\nEnter: proximo, A: anterior, P: reproduzir (%d ms), V ms: velocidade, G n: ir para, Q: sair: ",
+               milissegundos);
+        if (!tecladoLerLinha(entrada, sizeof(entrada))) {
+            break;
+        }
+        char comando = (char) toupper((unsigned char) entrada[0]);
+        if (comando == '\0') {
+            avancarReproducao(&reproducao);
+        } else if (comando == 'A') {
+            if (reproducao.posicao > 0) irParaMovimento(&reproducao, reproducao.posicao - 1);
+        } else if (comando == 'P') {
+            while (avancarReproducao(&reproducao)) {
+                exibirReproducao(&reproducao, pinos);
+                cronometroEsperar(milissegundos);
+            }
+        } else if (comando == 'V') {
+            int novo = atoi(entrada + 1);
+            if (novo >= 0) milissegundos = novo;
+        } else if (comando == 'G') {
+            long destino = atol(entrada + 1);
+            if (destino < 0 || !irParaMovimento(&reproducao, (size_t) destino)) {
+                printf("Movimento fora da gravacao (0 a %zu). Pressione Enter para continuar...",
+                       reproducao.totalMovimentos);
+                tecladoEsperarEnter();
+            }
+        } else if (comando == 'Q') {
+            break;
+        }
+    }
+
+    liberarReproducao(&reproducao);
+    for (int i = 0; i < partida->numPinos; i++) {
+        liberarPilha(pinos[i]);
+    }
+    liberarHistoricoMovimentos(gravacao);
+}
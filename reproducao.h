@@ -0,0 +1,34 @@
+#ifndef REPRODUCAO_H
+#define REPRODUCAO_H
+
+#include <stddef.h> // Para size_t
+#include <stdint.h> // Para uint64_t
+#include "estado.h"
+#include "historico.h" // Para Partida e HistoricoMovimentos
+
+// Movimentos entre dois pontos de controle: ir para qualquer movimento custa
+// no máximo esse número de movimentos reaplicados a partir do ponto anterior
+#define REPRODUCAO_INTERVALO_PADRAO 64
+
+// Tempo padrão entre dois quadros da reprodução automática
+#define REPRODUCAO_MILISSEGUNDOS_PADRAO 300
+
+// Reprodução de uma partida gravada
+typedef struct {
+    const HistoricoMovimentos* gravacao; // Movimentos compactados da partida
+    EstadoTorres estado;                 // Posição depois de 'posicao' movimentos
+    size_t posicao;                      // Movimentos já aplicados
+    size_t totalMovimentos;              // Movimentos reproduzíveis (até o primeiro inválido, se houver)
+    size_t intervalo;                    // Movimentos entre dois pontos de controle
+    uint64_t* pontosDeControle;          // numPinos máscaras a cada 'intervalo' movimentos
+    size_t numPontosDeControle;
+} Reproducao;
+
+// Protótipos do motor de reprodução
+int iniciarReproducao(Reproducao* reproducao, const HistoricoMovimentos* gravacao, int numDiscos, size_t intervalo);
+int avancarReproducao(Reproducao* reproducao);
+int irParaMovimento(Reproducao* reproducao, size_t indice);
+void liberarReproducao(Reproducao* reproducao);
+void reproduzirPartida(const Partida* partida);
+
+#endif // REPRODUCAO_H
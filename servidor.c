@@ -0,0 +1,447 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // Para sigaction e fcntl
+#endif
+
+#include "servidor.h"
+#include <stdio.h>
+
+#ifdef __linux__
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "estado.h"        // Estado de cada partida
+#include "historico.h"     // Gravação dos movimentos e histórico das partidas concluídas
+#include "frame_stewart.h" // Mínimo de movimentos, para os movimentos desperdiçados
+#include "pool.h"          // Pool de sessões
+
+// Eventos tratados por chamada de epoll_wait
+#define EVENTOS_POR_ESPERA 256
+
+// Sessões alocadas por vez no pool
+#define SESSOES_POR_BLOCO 256
+
+// Estado de uma conexão: a partida do cliente e os buffers de entrada e saída.
+// Substitui, no servidor, as variáveis globais do jogo interativo (nomeJogadorAtual etc.).
+typedef struct Sessao {
+    int descritor;
+    uint32_t eventos;                   // Eventos registrados no epoll
+    int emJogo;                         // 1 depois de NEW, até a vitória
+    EstadoTorres estado;
+    char nomeJogador[50];
+    HistoricoMovimentos* gravacao;      // Movimentos da partida atual
+    uint64_t distanciaInicial;          // Mínimo de movimentos da partida
+    char entrada[SERVIDOR_MAX_LINHA];   // Linha sendo recebida
+    size_t tamanhoEntrada;
+    char saida[SERVIDOR_MAX_SAIDA];     // Respostas ainda não enviadas
+    size_t inicioSaida;
+    size_t tamanhoSaida;
+    int encerrar;                       // Fecha a conexão depois de enviar a saída pendente
+    struct Sessao* anterior;            // Lista das sessões abertas
+    struct Sessao* proxima;
+} Sessao;
+
+// Dados do servidor
+typedef struct {
+    int epoll;
+    int escuta;
+    PoolObjetos poolSessoes;
+    Sessao* sessoes;
+    size_t sessoesAbertas;
+    size_t maiorNumeroDeSessoes;
+    unsigned long long comandos;
+} Servidor;
+
+// Pedido de parada (SIGINT/SIGTERM)
+static volatile sig_atomic_t pararServidor = 0;
+
+static void tratarSinalParada(int sinal) {
+    (void) sinal;
+    pararServidor = 1;
+}
+
+// Coloca um descritor em modo não bloqueante
+static int tornarNaoBloqueante(int descritor) {
+    int flags = fcntl(descritor, F_GETFL, 0);
+    return (flags >= 0 && fcntl(descritor, F_SETFL, flags | O_NONBLOCK) == 0) ? 0 : -1;
+}
+
+// Acrescenta uma resposta formatada à saída da sessão
+static void responder(Sessao* sessao, const char* formato, ...) {
+    if (sessao->encerrar) {
+        return;
+    }
+    // Compacta o buffer antes de escrever no fim
+    if (sessao->inicioSaida > 0) {
+        memmove(sessao->saida, sessao->saida + sessao->inicioSaida, sessao->tamanhoSaida);
+        sessao->inicioSaida = 0;
+    }
+    size_t livre = SERVIDOR_MAX_SAIDA - sessao->tamanhoSaida;
+    va_list argumentos;
+    va_start(argumentos, formato);
+    int escritos = vsnprintf(sessao->saida + sessao->tamanhoSaida, livre, formato, argumentos);
+    va_end(argumentos);
+    if (escritos < 0 || (size_t) escritos >= livre) {
+        sessao->encerrar = 1; // O cliente não está lendo as respostas
+        return;
+    }
+    sessao->tamanhoSaida += (size_t) escritos;
+}
+
+// Converte a letra de um pino no seu índice, ou -1
+static int indiceDoPino(char letra, int numPinos) {
+    letra = (char) toupper((unsigned char) letra);
+    return (letra >= 'A' && letra < 'A' + numPinos) ? letra - 'A' : -1;
+}
+
+// NEW n [k] [nome]
+static void comandoNovaPartida(Sessao* sessao, const char* argumentos) {
+    int numDiscos = 0;
+    int numPinos = ESTADO_MIN_PINOS;
+    char nome[sizeof(sessao->nomeJogador)] = "anonimo";
+    if (sscanf(argumentos, "%d %d %49s", &numDiscos, &numPinos, nome) < 1 ||
+        numDiscos < 1 || numDiscos > ESTADO_MAX_DISCOS || numPinos < ESTADO_MIN_PINOS || numPinos > ESTADO_MAX_PINOS) {
+        responder(sessao, "ERR use NEW n [k] [nome] com 1 a %d discos e %d a %d pinos\n",
+                  ESTADO_MAX_DISCOS, ESTADO_MIN_PINOS, ESTADO_MAX_PINOS);
+        return;
+    }
+    HistoricoMovimentos* gravacao = criarHistoricoMovimentos(numPinos);
+    if (gravacao == NULL) {
+        responder(sessao, "ERR sem memoria\n");
+        return;
+    }
+    liberarHistoricoMovimentos(sessao->gravacao);
+    sessao->gravacao = gravacao;
+    strcpy(sessao->nomeJogador, nome);
+    inicializarEstado(&sessao->estado, numDiscos, numPinos, 0);
+    sessao->distanciaInicial = movimentosOtimosMultiPinos(numDiscos, numPinos);
+    sessao->emJogo = 1;
+    responder(sessao, "OK NEW %d %d\n", numDiscos, numPinos);
+}
+
+// MOVE AB
+static void comandoMover(Sessao* sessao, const char* argumentos) {
+    if (!sessao->emJogo) {
+        responder(sessao, "ERR nenhuma partida em andamento (use NEW)\n");
+        return;
+    }
+    while (*argumentos == ' ') argumentos++;
+    int numPinos = sessao->estado.numPinos;
+    int origem = indiceDoPino(argumentos[0], numPinos);
+    int destino = (origem >= 0) ? indiceDoPino(argumentos[1], numPinos) : -1;
+    if (origem < 0 || destino < 0 || estadoMover(&sessao->estado, origem, destino) == -1) {
+        responder(sessao, "ERR movimento invalido\n");
+        return;
+    }
+    registrarMovimento(sessao->gravacao, origem, destino);
+    int movimentos = sessao->gravacao->numMovimentos;
+    if (!estadoConcluido(&sessao->estado, numPinos - 1)) {
+        responder(sessao, "OK MOVE %d\n", movimentos);
+        return;
+    }
+    sessao->gravacao->movimentosDesperdicados = movimentos - (int) sessao->distanciaInicial;
+    adicionarPartida(sessao->nomeJogador, sessao->estado.numDiscos, numPinos, sessao->gravacao);
+    responder(sessao, "OK WIN %d %d\n", movimentos, sessao->gravacao->movimentosDesperdicados);
+    liberarHistoricoMovimentos(sessao->gravacao);
+    sessao->gravacao = NULL;
+    sessao->emJogo = 0;
+}
+
+// STATE: discos de cada pino, da base ao topo
+static void comandoEstado(Sessao* sessao) {
+    if (!sessao->emJogo) {
+        responder(sessao, "ERR nenhuma partida em andamento (use NEW)\n");
+        return;
+    }
+    // Até 64 discos de 2 dígitos e separadores por pino, mais o cabeçalho
+    char linha[ESTADO_MAX_PINOS * (ESTADO_MAX_DISCOS * 3 + 2) + 64];
+    int tamanho = snprintf(linha, sizeof(linha), "STATE %d %d %d", sessao->estado.numDiscos,
+                           sessao->estado.numPinos, sessao->gravacao->numMovimentos);
+    for (int p = 0; p < sessao->estado.numPinos; p++) {
+        uint64_t pino = sessao->estado.pinos[p];
+        linha[tamanho++] = ' ';
+        if (pino == 0) {
+            linha[tamanho++] = '-';
+            continue;
+        }
+        // Da base (bit mais alto) ao topo (bit mais baixo)
+        for (int primeiro = 1; pino != 0; primeiro = 0) {
+            int bit = ESTADO_BIT_MAIS_ALTO(pino);
+            pino &= ~((uint64_t) 1 << bit);
+            tamanho += snprintf(linha + tamanho, sizeof(linha) - (size_t) tamanho, primeiro ? "%d" : ",%d", bit + 1);
+        }
+    }
+    linha[tamanho] = '\0';
+    responder(sessao, "%s\n", linha);
+}
+
+// Interpreta uma linha completa recebida do cliente
+static void processarLinha(Servidor* servidor, Sessao* sessao, char* linha) {
+    servidor->comandos++;
+    size_t tamanho = strlen(linha);
+    if (tamanho > 0 && linha[tamanho - 1] == '\r') linha[--tamanho] = '\0';
+    char comando[8] = "";
+    size_t i = 0;
+    while (i < tamanho && linha[i] != ' ' && i < sizeof(comando) - 1) {
+        comando[i] = (char) toupper((unsigned char) linha[i]);
+        i++;
+    }
+    comando[i] = '\0';
+    const char* argumentos = linha + i;
+
+    if (strcmp(comando, "NEW") == 0) {
+        comandoNovaPartida(sessao, argumentos);
+    } else if (strcmp(comando, "MOVE") == 0) {
+        comandoMover(sessao, argumentos);
+    } else if (strcmp(comando, "STATE") == 0) {
+        comandoEstado(sessao);
+    } else if (strcmp(comando, "QUIT") == 0) {
+        responder(sessao, "OK BYE\n");
+        sessao->encerrar = 1;
+    } else if (tamanho > 0) {
+        responder(sessao, "ERR comando desconhecido (NEW, MOVE, STATE, QUIT)\n");
+    }
+}
+
+// Fecha a conexão e devolve a sessão ao pool
+static void fecharSessao(Servidor* servidor, Sessao* sessao) {
+    epoll_ctl(servidor->epoll, EPOLL_CTL_DEL, sessao->descritor, NULL);
+    close(sessao->descritor);
+    liberarHistoricoMovimentos(sessao->gravacao);
+    if (sessao->anterior != NULL) sessao->anterior->proxima = sessao->proxima;
+    else servidor->sessoes = sessao->proxima;
+    if (sessao->proxima != NULL) sessao->proxima->anterior = sessao->anterior;
+    servidor->sessoesAbertas--;
+    devolverAoPool(&servidor->poolSessoes, sessao);
+}
+
+// Aceita todas as conexões pendentes
+static void aceitarConexoes(Servidor* servidor) {
+    while (1) {
+        int descritor = accept(servidor->escuta, NULL, NULL);
+        if (descritor < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("Erro ao aceitar conexao");
+            }
+            return;
+        }
+        Sessao* sessao = (Sessao*) obterDoPool(&servidor->poolSessoes);
+        if (sessao == NULL || tornarNaoBloqueante(descritor) != 0) {
+            perror("Erro ao preparar sessao");
+            if (sessao != NULL) devolverAoPool(&servidor->poolSessoes, sessao);
+            close(descritor);
+            continue;
+        }
+        memset(sessao, 0, sizeof(Sessao));
+        sessao->descritor = descritor;
+        sessao->eventos = EPOLLIN;
+        struct epoll_event evento;
+        evento.events = sessao->eventos;
+        evento.data.ptr = sessao;
+        if (epoll_ctl(servidor->epoll, EPOLL_CTL_ADD, descritor, &evento) != 0) {
+            perror("Erro ao registrar sessao no epoll");
+            devolverAoPool(&servidor->poolSessoes, sessao);
+            close(descritor);
+            continue;
+        }
+        sessao->proxima = servidor->sessoes;
+        if (servidor->sessoes != NULL) servidor->sessoes->anterior = sessao;
+        servidor->sessoes = sessao;
+        servidor->sessoesAbertas++;
+        if (servidor->sessoesAbertas > servidor->maiorNumeroDeSessoes) {
+            servidor->maiorNumeroDeSessoes = servidor->sessoesAbertas;
+        }
+    }
+}
+
+// Lê o que chegou e processa as linhas completas; retorna 0 se o cliente fechou a conexão
+static int lerSessao(Servidor* servidor, Sessao* sessao) {
+    char bloco[1024];
+    while (1) {
+        ssize_t lidos = read(sessao->descritor, bloco, sizeof(bloco));
+        if (lidos == 0) {
+            return 0;
+        }
+        if (lidos < 0) {
+            return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 1 : 0;
+        }
+        for (ssize_t i = 0; i < lidos; i++) {
+            if (bloco[i] == '\n') {
+                sessao->entrada[sessao->tamanhoEntrada] = '\0';
+                processarLinha(servidor, sessao, sessao->entrada);
+                sessao->tamanhoEntrada = 0;
+            } else if (sessao->tamanhoEntrada < SERVIDOR_MAX_LINHA - 1) {
+                sessao->entrada[sessao->tamanhoEntrada++] = bloco[i];
+            } else {
+                responder(sessao, "ERR linha longa demais\n");
+                sessao->encerrar = 1;
+                return 1;
+            }
+        }
+    }
+}
+
+// Envia o máximo possível da saída pendente; retorna 0 em caso de erro na conexão
+static int escreverSessao(Sessao* sessao) {
+    while (sessao->tamanhoSaida > 0) {
+        ssize_t enviados = send(sessao->descritor, sessao->saida + sessao->inicioSaida, sessao->tamanhoSaida,
+                                MSG_NOSIGNAL);
+        if (enviados < 0) {
+            return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 1 : 0;
+        }
+        sessao->inicioSaida += (size_t) enviados;
+        sessao->tamanhoSaida -= (size_t) enviados;
+    }
+    sessao->inicioSaida = 0;
+    return 1;
+}
+
+// Pede EPOLLOUT só enquanto houver saída pendente
+static void atualizarEventos(Servidor* servidor, Sessao* sessao) {
+    uint32_t desejados = EPOLLIN | (sessao->tamanhoSaida > 0 ? EPOLLOUT : 0);
+    if (desejados != sessao->eventos) {
+        struct epoll_event evento;
+        evento.events = desejados;
+        evento.data.ptr = sessao;
+        epoll_ctl(servidor->epoll, EPOLL_CTL_MOD, sessao->descritor, &evento);
+        sessao->eventos = desejados;
+    }
+}
+
+// Cria o socket local de escuta (não bloqueante)
+static int criarSocketDeEscuta(const char* caminho) {
+    struct sockaddr_un endereco;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        fprintf(stderr, "Erro: caminho do socket longo demais: %s\n", caminho);
+        return -1;
+    }
+    // Só remove o que for um socket deixado por uma execução anterior: um caminho errado
+    // (ex: historico.dat) não pode apagar um arquivo comum
+    struct stat informacoes;
+    if (lstat(caminho, &informacoes) == 0) {
+        if (!S_ISSOCK(informacoes.st_mode)) {
+            fprintf(stderr, "Erro: %s ja existe e nao e um socket; nada foi alterado.\n", caminho);
+            return -1;
+        }
+        unlink(caminho);
+    }
+    int escuta = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (escuta < 0) {
+        perror("Erro ao criar socket");
+        return -1;
+    }
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+    if (bind(escuta, (struct sockaddr*) &endereco, sizeof(endereco)) != 0 || listen(escuta, SOMAXCONN) != 0 ||
+        tornarNaoBloqueante(escuta) != 0) {
+        perror("Erro ao abrir o socket do servidor");
+        close(escuta);
+        return -1;
+    }
+    return escuta;
+}
+
+/**
+ * @brief Hospeda muitas partidas simultâneas em um único processo, por um socket local.
+ * * Um laço de eventos (epoll) atende todas as conexões sem bloquear: cada conexão é uma
+ * * sessão com a sua própria partida e os seus buffers, vinda de um pool. O protocolo é
+ * * descrito em servidor.h. Termina com SIGINT ou SIGTERM.
+ * @param caminho O caminho do socket (NULL usa SERVIDOR_CAMINHO_PADRAO).
+ * @return 0 ao terminar normalmente, 1 em caso de erro.
+ */
+int executarServidor(const char* caminho) {
+    if (caminho == NULL) caminho = SERVIDOR_CAMINHO_PADRAO;
+    Servidor servidor;
+    memset(&servidor, 0, sizeof(servidor));
+    servidor.escuta = criarSocketDeEscuta(caminho);
+    if (servidor.escuta < 0) {
+        return 1;
+    }
+    servidor.epoll = epoll_create1(0);
+    struct epoll_event evento;
+    evento.events = EPOLLIN;
+    evento.data.ptr = NULL; // NULL identifica o socket de escuta
+    if (servidor.epoll < 0 || epoll_ctl(servidor.epoll, EPOLL_CTL_ADD, servidor.escuta, &evento) != 0) {
+        perror("Erro ao criar o epoll do servidor");
+        if (servidor.epoll >= 0) close(servidor.epoll);
+        close(servidor.escuta);
+        unlink(caminho);
+        return 1;
+    }
+    inicializarPool(&servidor.poolSessoes, sizeof(Sessao), SESSOES_POR_BLOCO);
+    inicializarHistoricoGlobal(); // Partidas concluídas entram no histórico comum
+
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = tratarSinalParada;
+    sigemptyset(&acao.sa_mask);
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+    printf("Servidor ouvindo em %s (Ctrl+C para encerrar)\n", caminho);
+    fflush(stdout);
+
+    struct epoll_event eventos[EVENTOS_POR_ESPERA];
+    while (!pararServidor) {
+        int prontos = epoll_wait(servidor.epoll, eventos, EVENTOS_POR_ESPERA, -1);
+        if (prontos < 0) {
+            if (errno == EINTR) continue;
+            perror("Erro no epoll_wait");
+            break;
+        }
+        for (int i = 0; i < prontos; i++) {
+            Sessao* sessao = (Sessao*) eventos[i].data.ptr;
+            if (sessao == NULL) {
+                aceitarConexoes(&servidor);
+                continue;
+            }
+            int aberta = !(eventos[i].events & EPOLLERR);
+            if (aberta && (eventos[i].events & (EPOLLIN | EPOLLHUP))) {
+                aberta = lerSessao(&servidor, sessao);
+            }
+            if (aberta) {
+                aberta = escreverSessao(sessao);
+            }
+            if (!aberta || (sessao->encerrar && sessao->tamanhoSaida == 0)) {
+                fecharSessao(&servidor, sessao);
+            } else {
+                atualizarEventos(&servidor, sessao);
+            }
+        }
+    }
+
+    while (servidor.sessoes != NULL) {
+        fecharSessao(&servidor, servidor.sessoes);
+    }
+    printf("Servidor encerrado: %llu comandos, no maximo %zu sessoes simultaneas\n",
+           servidor.comandos, servidor.maiorNumeroDeSessoes);
+    liberarPool(&servidor.poolSessoes);
+    liberarHistoricoGlobal();
+    close(servidor.epoll);
+    close(servidor.escuta);
+    unlink(caminho);
+    return 0;
+}
+
+#else
+
+/**
+ * @brief O modo servidor usa epoll e sockets locais, disponíveis apenas no Linux.
+ */
+int executarServidor(const char* caminho) {
+    (void) caminho;
+    fprintf(stderr, "Erro: o modo servidor (epoll) so esta disponivel no Linux.\n");
+    return 1;
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+// Caminho padrão do socket local do modo servidor
+#define SERVIDOR_CAMINHO_PADRAO "torre_hanoi.sock"
+
+// Maior comprimento de uma linha do protocolo (incluindo o '\n')
+#define SERVIDOR_MAX_LINHA 128
+
+// Saída pendente por sessão; um cliente que não lê as respostas é desconectado ao passar disso
+#define SERVIDOR_MAX_SAIDA 4096
+
+// Protocolo (uma linha por comando, respostas começam com OK, STATE ou ERR):
+//   NEW n [k] [nome] -> OK NEW n k                  inicia uma partida de n discos e k pinos
+//   MOVE AB          -> OK MOVE m | OK WIN m d      move o topo de A para B (m movimentos, d desperdiçados)
+//   STATE            -> STATE n k m A B ...         discos de cada pino, da base ao topo ("-" se vazio)
+//   QUIT             -> OK BYE                      encerra a sessão
+// Partidas concluídas são gravadas no histórico com o nome informado em NEW.
+
+// Protótipo do modo servidor
+int executarServidor(const char* caminho);
+
+#endif // SERVIDOR_H
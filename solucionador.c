@@ -0,0 +1,372 @@
+#include "solucionador.h"
+#include "cronometro.h"
+#include "tabelas_otimas.h" // Primeiros 2^16 - 1 movimentos da sequência, pré-calculados na compilação
+#include <stdio.h>
+#include <stdlib.h>
+
+// Quantidade de movimentos gerados por bloco no modo buffer do benchmark
+#define TAMANHO_BLOCO_BENCHMARK 4096
+
+// Limite padrão de movimentos do benchmark (2^n - 1 é impraticável para n grande)
+#define LIMITE_PADRAO_BENCHMARK 100000000ULL
+
+/**
+ * @brief Retorna o número mínimo de movimentos para resolver a torre: 2^n - 1.
+ * * Para 64 discos o resultado (2^64 - 1) ainda cabe exatamente em um uint64_t.
+ */
+uint64_t totalMovimentosOtimos(int numDiscos) {
+    if (numDiscos <= 0) {
+        return 0;
+    }
+    return estadoMascaraCompleta(numDiscos);
+}
+
+/**
+ * @brief Monta a tabela que traduz os pinos "canônicos" da fórmula iterativa para os pinos reais.
+ * * A fórmula abaixo leva a torre do pino 0 ao pino 2 quando n é ímpar e ao pino 1 quando n é par,
+ * * então a ordem dos pinos auxiliares é trocada para n par.
+ */
+static void montarPermutacao(int numDiscos, int pinoOrigem, int pinoDestino, int permutacao[3]) {
+    int pinoAuxiliar = 3 - pinoOrigem - pinoDestino;
+    permutacao[0] = pinoOrigem;
+    if (numDiscos % 2 == 1) {
+        permutacao[1] = pinoAuxiliar;
+        permutacao[2] = pinoDestino;
+    } else {
+        permutacao[1] = pinoDestino;
+        permutacao[2] = pinoAuxiliar;
+    }
+}
+
+/**
+ * @brief Calcula o movimento de número m (começando em 1) da solução ótima canônica.
+ * * Até TABELA_NUM_MOVIMENTOS (a solução inteira de até TABELA_MAX_DISCOS discos) vem da tabela
+ * * gerada na compilação; depois, da fórmula. Origem: (m & (m - 1)) mod 3. Destino: ((m | (m - 1)) + 1) mod 3.
+ * * A soma é feita em aritmética modular para não estourar quando m = 2^64 - 1.
+ */
+static inline void movimentoCanonico(uint64_t m, int* origem, int* destino) {
+    if (m <= TABELA_NUM_MOVIMENTOS) {
+        unsigned movimento = movimentoTabelado(m);
+        *origem = (int)(movimento >> 2);
+        *destino = (int)(movimento & 3);
+        return;
+    }
+    *origem = (int)((m & (m - 1)) % 3);
+    *destino = (int)(((m | (m - 1)) % 3 + 1) % 3);
+}
+
+/**
+ * @brief Retorna o movimento de índice 'indice' (começando em 0) da solução ótima, sem gerar os anteriores.
+ * @param numDiscos O número de discos.
+ * @param pinoOrigem O pino onde a torre começa.
+ * @param pinoDestino O pino para onde a torre deve ir.
+ * @param indice A posição do movimento na sequência (0 a 2^n - 2).
+ * @return O movimento correspondente.
+ */
+Movimento movimentoOtimo(int numDiscos, int pinoOrigem, int pinoDestino, uint64_t indice) {
+    int permutacao[3];
+    int origem, destino;
+    montarPermutacao(numDiscos, pinoOrigem, pinoDestino, permutacao);
+    movimentoCanonico(indice + 1, &origem, &destino);
+
+    Movimento movimento;
+    movimento.origem = (unsigned char)permutacao[origem];
+    movimento.destino = (unsigned char)permutacao[destino];
+    return movimento;
+}
+
+/**
+ * @brief Gera a sequência ótima de forma iterativa, chamando 'callback' para cada movimento.
+ * * Não usa recursão nem memória proporcional a n, então funciona para até 64 discos.
+ * @param numDiscos O número de discos (1 a ESTADO_MAX_DISCOS).
+ * @param pinoOrigem O pino onde a torre começa.
+ * @param pinoDestino O pino para onde a torre deve ir.
+ * @param limite Número máximo de movimentos a gerar (a sequência completa tem 2^n - 1).
+ * @param callback Função chamada para cada movimento; um retorno diferente de 0 interrompe.
+ * @param contexto Ponteiro repassado ao callback.
+ * @return O número de movimentos gerados.
+ */
+uint64_t resolverComCallback(int numDiscos, int pinoOrigem, int pinoDestino, uint64_t limite,
+                             CallbackMovimento callback, void* contexto) {
+    uint64_t total = totalMovimentosOtimos(numDiscos);
+    if (limite < total) {
+        total = limite;
+    }
+
+    int permutacao[3];
+    montarPermutacao(numDiscos, pinoOrigem, pinoDestino, permutacao);
+
+    for (uint64_t m = 1; m <= total; m++) {
+        int origem, destino;
+        movimentoCanonico(m, &origem, &destino);
+        if (callback(permutacao[origem], permutacao[destino], contexto) != 0) {
+            return m; // Interrompido pelo callback
+        }
+        if (m == UINT64_MAX) {
+            break; // Evita que m volte a zero com 64 discos
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Preenche um buffer com um trecho da sequência ótima.
+ * * Permite gerar a solução em blocos a partir de qualquer posição.
+ * @param numDiscos O número de discos.
+ * @param pinoOrigem O pino onde a torre começa.
+ * @param pinoDestino O pino para onde a torre deve ir.
+ * @param primeiro Índice (começando em 0) do primeiro movimento do trecho.
+ * @param buffer Vetor de saída.
+ * @param capacidade Quantidade de movimentos que cabem no buffer.
+ * @return O número de movimentos escritos (menor que 'capacidade' no fim da sequência).
+ */
+size_t gerarMovimentosOtimos(int numDiscos, int pinoOrigem, int pinoDestino, uint64_t primeiro,
+                             Movimento* buffer, size_t capacidade) {
+    uint64_t total = totalMovimentosOtimos(numDiscos);
+    if (primeiro >= total) {
+        return 0;
+    }
+    uint64_t restantes = total - primeiro;
+    size_t quantidade = (restantes < capacidade) ? (size_t)restantes : capacidade;
+
+    int permutacao[3];
+    montarPermutacao(numDiscos, pinoOrigem, pinoDestino, permutacao);
+
+    uint64_t m = primeiro + 1;
+    for (size_t i = 0; i < quantidade; i++, m++) {
+        int origem, destino;
+        movimentoCanonico(m, &origem, &destino);
+        buffer[i].origem = (unsigned char)permutacao[origem];
+        buffer[i].destino = (unsigned char)permutacao[destino];
+    }
+    return quantidade;
+}
+
+/**
+ * @brief Aplica a solução ótima sobre pilhas na posição inicial (todos os discos no pino 0).
+ * * Usa desempilhar/empilhar, exercitando o mesmo caminho de movimento do jogo.
+ * @param pinos Os três pinos do jogo.
+ * @param numDiscos O número de discos empilhados no pino 0.
+ * @param limite Número máximo de movimentos a aplicar.
+ * @return O número de movimentos aplicados.
+ */
+uint64_t resolverSobrePilhas(Pilha* pinos[], int numDiscos, uint64_t limite) {
+    uint64_t total = totalMovimentosOtimos(numDiscos);
+    if (limite < total) {
+        total = limite;
+    }
+
+    int permutacao[3];
+    montarPermutacao(numDiscos, 0, 2, permutacao);
+
+    for (uint64_t m = 1; m <= total; m++) {
+        int origem, destino;
+        movimentoCanonico(m, &origem, &destino);
+        empilhar(pinos[permutacao[destino]], desempilhar(pinos[permutacao[origem]]));
+        if (m == UINT64_MAX) {
+            break;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Aplica a solução ótima sobre o estado compacto (todos os discos no pino 0).
+ * * O disco do movimento m é o bit mais baixo de m, então cada movimento são duas operações de bits.
+ * @param estado O estado compacto, na posição inicial.
+ * @param limite Número máximo de movimentos a aplicar.
+ * @return O número de movimentos aplicados.
+ */
+uint64_t resolverSobreEstado(EstadoTorres* estado, uint64_t limite) {
+    uint64_t total = totalMovimentosOtimos(estado->numDiscos);
+    if (limite < total) {
+        total = limite;
+    }
+
+    int permutacao[3];
+    montarPermutacao(estado->numDiscos, 0, 2, permutacao);
+
+    for (uint64_t m = 1; m <= total; m++) {
+        int origem, destino;
+        movimentoCanonico(m, &origem, &destino);
+        uint64_t bitDisco = m & (0 - m);
+        estado->pinos[permutacao[origem]] ^= bitDisco;
+        estado->pinos[permutacao[destino]] |= bitDisco;
+        if (m == UINT64_MAX) {
+            break;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Calcula, sem busca, a distância de uma posição qualquer (3 pinos) até o objetivo e o melhor próximo movimento.
+ * * Percorre os discos do maior para o menor guardando para onde cada um precisa ir. Se o disco d
+ * * já está no alvo, o alvo de d - 1 não muda; se não está, d terá de fazer exatamente um movimento
+ * * (custo 2^(d-1), contando os discos menores que saem e voltam) e os discos menores precisam antes
+ * * ir para o terceiro pino. O próximo movimento ótimo é o do menor disco fora do alvo.
+ * @param estado A posição (deve ter 3 pinos).
+ * @param pinoDestino O pino onde todos os discos devem terminar.
+ * @param analise Recebe a distância e o próximo movimento.
+ * @return 0 em caso de sucesso, -1 se o estado não tiver 3 pinos ou o destino for inválido.
+ */
+int analisarEstado(const EstadoTorres* estado, int pinoDestino, AnalisePosicao* analise) {
+    if (estado->numPinos != 3 || pinoDestino < 0 || pinoDestino > 2) {
+        return -1;
+    }
+    analise->movimentosRestantes = 0;
+    analise->proximo.origem = analise->proximo.destino = 0;
+
+    int alvo = pinoDestino;
+    for (int d = estado->numDiscos; d >= 1; d--) {
+        uint64_t bitDisco = (uint64_t)1 << (d - 1);
+        int pino = (estado->pinos[0] & bitDisco) ? 0 : (estado->pinos[1] & bitDisco) ? 1 : 2;
+        if (pino != alvo) {
+            analise->movimentosRestantes += bitDisco; // 2^(d-1)
+            analise->proximo.origem = (unsigned char) pino;
+            analise->proximo.destino = (unsigned char) alvo;
+            alvo = 3 - pino - alvo; // Os discos menores precisam liberar os dois pinos
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Versão de analisarEstado para as pilhas do jogo (listas ou bitboards), em O(n).
+ * @param pinos Os pinos do jogo.
+ * @param numPinos O número de pinos (a análise só existe para 3).
+ * @param numDiscos O número total de discos da partida.
+ * @param pinoDestino O pino onde todos os discos devem terminar.
+ * @param analise Recebe a distância e o próximo movimento.
+ * @return 0 em caso de sucesso, -1 se a posição não puder ser analisada.
+ */
+int analisarPilhas(Pilha* pinos[], int numPinos, int numDiscos, int pinoDestino, AnalisePosicao* analise) {
+    if (numPinos != 3 || numDiscos < 0 || numDiscos > ESTADO_MAX_DISCOS) {
+        return -1;
+    }
+    EstadoTorres estado;
+    inicializarEstado(&estado, numDiscos, numPinos, 0);
+    for (int i = 0; i < numPinos; i++) {
+        if (pinos[i]->motor == MOTOR_BITBOARD) {
+            estado.pinos[i] = pinos[i]->discos;
+            continue;
+        }
+        estado.pinos[i] = 0;
+        for (No* atual = pinos[i]->topo; atual != NULL; atual = atual->abaixo) {
+            estado.pinos[i] |= (uint64_t)1 << (atual->tamanhoDisco - 1);
+        }
+    }
+    return analisarEstado(&estado, pinoDestino, analise);
+}
+
+// Callback vazio usado para medir apenas o custo de gerar os movimentos
+static int callbackContador(int origem, int destino, void* contexto) {
+    uint64_t* soma = (uint64_t*) contexto;
+    *soma += (uint64_t)(origem * 3 + destino); // Evita que o compilador descarte o laço
+    return 0;
+}
+
+// Imprime uma linha de resultado do benchmark
+static void imprimirResultado(const char* nome, uint64_t movimentos, double segundos) {
+    double porSegundo = (segundos > 0) ? (double)movimentos / segundos : 0.0;
+    printf("%-22s %14llu movimentos  %9.3f s  %12.0f mov/s\n",
+           nome, (unsigned long long)movimentos, segundos, porSegundo);
+}
+
+// Aplica a solução sobre três pilhas do motor escolhido e mede a vazão
+static int benchmarkPilhas(const char* nome, MotorPilha motor, int numDiscos, uint64_t limite) {
+    Pilha* pinos[3];
+    pinos[0] = criarPilhaComMotor('A', motor);
+    pinos[1] = criarPilhaComMotor('B', motor);
+    pinos[2] = criarPilhaComMotor('C', motor);
+    if (pinos[0] == NULL || pinos[1] == NULL || pinos[2] == NULL) {
+        for (int i = 0; i < 3; i++) liberarPilha(pinos[i]);
+        return 0;
+    }
+    for (int i = numDiscos; i >= 1; i--) {
+        empilhar(pinos[0], i);
+    }
+
+    EstatisticasPool antes, depois;
+    obterEstatisticasPilha(&antes, NULL);
+    double inicio = cronometroSegundos();
+    uint64_t aplicados = resolverSobrePilhas(pinos, numDiscos, limite);
+    imprimirResultado(nome, aplicados, cronometroSegundos() - inicio);
+    obterEstatisticasPilha(&depois, NULL);
+    printf("%-22s %14llu alocacoes do sistema durante os movimentos\n", "",
+           (unsigned long long)(depois.alocacoesSistema - antes.alocacoesSistema));
+
+    int concluido = pilhaVazia(pinos[0]) && pilhaVazia(pinos[1]) && alturaPilha(pinos[2]) == numDiscos;
+    for (int i = 0; i < 3; i++) liberarPilha(pinos[i]);
+    return concluido;
+}
+
+/**
+ * @brief Modo benchmark: mede a vazão (movimentos por segundo) do solucionador e dos motores de estado.
+ * * Mede a geração por callback, a geração em buffer, o estado compacto e as pilhas dos dois motores.
+ * @param numDiscos O número de discos (1 a ESTADO_MAX_DISCOS).
+ * @param limite Número máximo de movimentos por medição (0 usa o padrão).
+ * @return 0 em caso de sucesso, 1 se os parâmetros forem inválidos.
+ */
+int executarBenchmarkSolucionador(int numDiscos, uint64_t limite) {
+    if (numDiscos < 1 || numDiscos > ESTADO_MAX_DISCOS) {
+        fprintf(stderr, "Erro: numero de discos deve estar entre 1 e %d.\n", ESTADO_MAX_DISCOS);
+        return 1;
+    }
+    if (limite == 0) {
+        limite = LIMITE_PADRAO_BENCHMARK;
+    }
+    uint64_t total = totalMovimentosOtimos(numDiscos);
+    int completo = (limite >= total); // Se a sequência inteira cabe no limite, confere o resultado
+    if (!completo) {
+        total = limite;
+    }
+
+    printf("Benchmark do solucionador: %d discos, %llu movimentos%s\n", numDiscos,
+           (unsigned long long)total, completo ? "" : " (sequencia parcial)");
+
+    // 1. Geração por callback
+    uint64_t soma = 0;
+    double inicio = cronometroSegundos();
+    uint64_t gerados = resolverComCallback(numDiscos, 0, 2, total, callbackContador, &soma);
+    imprimirResultado("callback", gerados, cronometroSegundos() - inicio);
+
+    // 2. Geração em buffer, em blocos
+    Movimento* bloco = (Movimento*) malloc(TAMANHO_BLOCO_BENCHMARK * sizeof(Movimento));
+    if (bloco == NULL) {
+        perror("Erro ao alocar memoria para o benchmark");
+        return 1;
+    }
+    gerados = 0;
+    inicio = cronometroSegundos();
+    while (gerados < total) {
+        size_t capacidade = TAMANHO_BLOCO_BENCHMARK;
+        if (total - gerados < capacidade) {
+            capacidade = (size_t)(total - gerados);
+        }
+        size_t escritos = gerarMovimentosOtimos(numDiscos, 0, 2, gerados, bloco, capacidade);
+        soma += bloco[escritos - 1].destino;
+        gerados += escritos;
+    }
+    imprimirResultado("buffer", gerados, cronometroSegundos() - inicio);
+    free(bloco);
+
+    // 3. Estado compacto (bitboard puro)
+    EstadoTorres estado;
+    inicializarEstado(&estado, numDiscos, 3, 0);
+    inicio = cronometroSegundos();
+    uint64_t aplicados = resolverSobreEstado(&estado, total);
+    imprimirResultado("estado compacto", aplicados, cronometroSegundos() - inicio);
+    int estadoOk = estadoConcluido(&estado, 2);
+
+    // 4. Pilhas (caminho de movimento de pilha.c)
+    int bitboardOk = benchmarkPilhas("pilha (bitboard)", MOTOR_BITBOARD, numDiscos, total);
+    int listaOk = benchmarkPilhas("pilha (lista)", MOTOR_LISTA, numDiscos, total);
+
+    if (completo) {
+        printf("Verificacao: estado %s, pilha bitboard %s, pilha lista %s\n",
+               estadoOk ? "ok" : "FALHOU", bitboardOk ? "ok" : "FALHOU", listaOk ? "ok" : "FALHOU");
+    }
+    printf("(soma de controle: %llu)\n", (unsigned long long)soma);
+    return (completo && !(estadoOk && bitboardOk && listaOk)) ? 1 : 0;
+}
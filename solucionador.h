@@ -0,0 +1,38 @@
+#ifndef SOLUCIONADOR_H
+#define SOLUCIONADOR_H
+
+#include <stddef.h> // Para size_t
+#include <stdint.h> // Para uint64_t
+#include "pilha.h"
+#include "estado.h"
+
+// Um movimento: índices dos pinos de origem e destino
+typedef struct {
+    unsigned char origem;
+    unsigned char destino;
+} Movimento;
+
+// Análise de uma posição: quanto falta para o objetivo e qual o melhor próximo movimento
+typedef struct {
+    uint64_t movimentosRestantes; // Menor número de movimentos até o objetivo
+    Movimento proximo;            // Primeiro movimento de um caminho ótimo (sem sentido se restantes == 0)
+} AnalisePosicao;
+
+// Função chamada para cada movimento gerado.
+// Deve retornar 0 para continuar ou qualquer outro valor para interromper a geração.
+typedef int (*CallbackMovimento)(int origem, int destino, void* contexto);
+
+// Protótipos das funções do solucionador
+uint64_t totalMovimentosOtimos(int numDiscos);
+Movimento movimentoOtimo(int numDiscos, int pinoOrigem, int pinoDestino, uint64_t indice);
+uint64_t resolverComCallback(int numDiscos, int pinoOrigem, int pinoDestino, uint64_t limite,
+                             CallbackMovimento callback, void* contexto);
+size_t gerarMovimentosOtimos(int numDiscos, int pinoOrigem, int pinoDestino, uint64_t primeiro,
+                             Movimento* buffer, size_t capacidade);
+uint64_t resolverSobrePilhas(Pilha* pinos[], int numDiscos, uint64_t limite);
+uint64_t resolverSobreEstado(EstadoTorres* estado, uint64_t limite);
+int analisarEstado(const EstadoTorres* estado, int pinoDestino, AnalisePosicao* analise);
+int analisarPilhas(Pilha* pinos[], int numPinos, int numDiscos, int pinoDestino, AnalisePosicao* analise);
+int executarBenchmarkSolucionador(int numDiscos, uint64_t limite);
+
+#endif // SOLUCIONADOR_H
@@ -0,0 +1,25 @@
+#ifndef TABELAS_OTIMAS_H
+#define TABELAS_OTIMAS_H
+
+#include <stdint.h> // Para uint64_t
+
+// Maior número de discos cuja solução ótima completa está pré-calculada
+#define TABELA_MAX_DISCOS 16
+
+// Movimentos na tabela: a solução completa de TABELA_MAX_DISCOS discos (2^16 - 1)
+#define TABELA_NUM_MOVIMENTOS ((1u << TABELA_MAX_DISCOS) - 1)
+
+// Sequência ótima canônica (a de movimentoCanonico, em solucionador.c), dois movimentos por byte:
+// o movimento m (começando em 1) fica no meio byte m - 1, com a origem nos bits 2-3 e o destino
+// nos bits 0-1. A sequência não depende de n: os 2^n - 1 primeiros movimentos resolvem n discos,
+// então a mesma tabela serve a todo n <= TABELA_MAX_DISCOS.
+// Gerada na compilação por gerador_tabelas.c (build/<CONFIG>/tabelas_otimas.c).
+extern const unsigned char tabelaMovimentosOtimos[(TABELA_NUM_MOVIMENTOS + 1) / 2];
+
+// Movimento m (1 a TABELA_NUM_MOVIMENTOS) da tabela, como (origem << 2) | destino nos pinos canônicos
+static inline unsigned movimentoTabelado(uint64_t m) {
+    uint64_t posicao = m - 1;
+    return (tabelaMovimentosOtimos[posicao >> 1] >> ((posicao & 1) << 2)) & 0xF;
+}
+
+#endif // TABELAS_OTIMAS_H
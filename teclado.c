@@ -0,0 +1,211 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // Para termios, poll e sigaction
+#endif
+
+#include "teclado.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <errno.h>
+
+#ifdef _WIN32
+#include <windows.h> // Para GetConsoleMode/SetConsoleMode
+#include <io.h>      // Para _read e _isatty
+#include <conio.h>   // Para _kbhit
+#else
+#include <unistd.h>  // Para read e isatty
+#include <termios.h> // Para o modo não canônico do terminal
+#include <poll.h>    // Para saber, sem esperar, se há teclas pendentes
+#endif
+
+// Bytes lidos da entrada padrão por vez: uma sequência colada chega de uma só vez
+#define TAMANHO_BUFFER_TECLADO 4096
+
+// Estado da camada de entrada
+static unsigned char bufferTeclado[TAMANHO_BUFFER_TECLADO];
+static size_t inicioTeclado = 0; // Próximo byte a entregar
+static size_t fimTeclado = 0;    // Fim dos bytes válidos em bufferTeclado
+static int fimDaEntrada = 0;     // 1 depois que a entrada padrão terminou
+static int modoBrutoAtivo = 0;   // 1 enquanto o terminal está sem eco e sem buffer de linha
+
+#ifdef _WIN32
+static DWORD modoOriginal;
+#else
+static struct termios modoOriginal;
+static struct sigaction acaoAnteriorInterrupcao;
+static struct sigaction acaoAnteriorTermino;
+
+// Ctrl+C ou término durante a partida: devolve o terminal ao modo normal antes de sair
+static void restaurarAoReceberSinal(int sinal) {
+    tcsetattr(STDIN_FILENO, TCSANOW, &modoOriginal);
+    signal(sinal, SIG_DFL);
+    raise(sinal);
+}
+#endif
+
+// Lê o que estiver disponível na entrada padrão, esperando se não houver nada; retorna 0 no fim da entrada
+static int preencherBuffer() {
+    if (fimDaEntrada) {
+        return 0;
+    }
+    fflush(stdout); // O prompt precisa estar visível antes de esperar
+#ifdef _WIN32
+    int lidos = _read(0, bufferTeclado, TAMANHO_BUFFER_TECLADO);
+#else
+    ssize_t lidos;
+    do {
+        lidos = read(STDIN_FILENO, bufferTeclado, TAMANHO_BUFFER_TECLADO);
+    } while (lidos < 0 && errno == EINTR);
+#endif
+    if (lidos <= 0) {
+        fimDaEntrada = 1;
+        return 0;
+    }
+    inicioTeclado = 0;
+    fimTeclado = (size_t) lidos;
+    return 1;
+}
+
+// Próximo byte da entrada, esperando se preciso
+static int lerByte() {
+    if (inicioTeclado == fimTeclado && !preencherBuffer()) {
+        return EOF;
+    }
+    return bufferTeclado[inicioTeclado++];
+}
+
+// Próximo byte, sem consumi-lo e sem esperar; -1 se nada chegou ainda
+static int espiarSemEsperar() {
+    if (inicioTeclado == fimTeclado && (!tecladoTeclaPendente() || !preencherBuffer())) {
+        return -1;
+    }
+    return bufferTeclado[inicioTeclado];
+}
+
+/**
+ * @brief Põe o terminal em modo bruto: cada tecla chega na hora, sem Enter e sem eco.
+ * * Sem efeito se a entrada não for um terminal (arquivo ou pipe). O modo original volta
+ * * com tecladoRestaurarModo, ao sair do programa ou com Ctrl+C.
+ */
+void tecladoAtivarModoBruto() {
+    if (modoBrutoAtivo) {
+        return;
+    }
+#ifdef _WIN32
+    HANDLE console = GetStdHandle(STD_INPUT_HANDLE);
+    if (!_isatty(0) || !GetConsoleMode(console, &modoOriginal) ||
+        !SetConsoleMode(console, modoOriginal & ~(DWORD)(ENABLE_LINE_INPUT | ENABLE_ECHO_INPUT))) {
+        return;
+    }
+#else
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &modoOriginal) != 0) {
+        return;
+    }
+    struct termios bruto = modoOriginal;
+    bruto.c_lflag &= ~(tcflag_t)(ICANON | ECHO); // Ctrl+C continua gerando SIGINT
+    bruto.c_cc[VMIN] = 1;
+    bruto.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSANOW, &bruto) != 0) {
+        return;
+    }
+    struct sigaction acao;
+    acao.sa_handler = restaurarAoReceberSinal;
+    sigemptyset(&acao.sa_mask);
+    acao.sa_flags = 0;
+    sigaction(SIGINT, &acao, &acaoAnteriorInterrupcao);
+    sigaction(SIGTERM, &acao, &acaoAnteriorTermino);
+#endif
+    modoBrutoAtivo = 1;
+    static int restauracaoRegistrada = 0;
+    if (!restauracaoRegistrada) {
+        atexit(tecladoRestaurarModo);
+        restauracaoRegistrada = 1;
+    }
+}
+
+/**
+ * @brief Devolve o terminal ao modo de linha (com eco), se o modo bruto estiver ativo.
+ * * Teclas já recebidas continuam no buffer para as próximas leituras.
+ */
+void tecladoRestaurarModo() {
+    if (!modoBrutoAtivo) {
+        return;
+    }
+#ifdef _WIN32
+    SetConsoleMode(GetStdHandle(STD_INPUT_HANDLE), modoOriginal);
+#else
+    tcsetattr(STDIN_FILENO, TCSANOW, &modoOriginal);
+    sigaction(SIGINT, &acaoAnteriorInterrupcao, NULL);
+    sigaction(SIGTERM, &acaoAnteriorTermino, NULL);
+#endif
+    modoBrutoAtivo = 0;
+}
+
+/**
+ * @brief Lê uma tecla, esperando se nenhuma chegou ainda.
+ * * Setas e teclas de função (ESC [ ...) chegam como uma única TECLADO_TECLA_ESPECIAL,
+ * * para não serem confundidas com letras de pinos.
+ * @return O código da tecla, TECLADO_TECLA_ESPECIAL ou EOF no fim da entrada.
+ */
+int tecladoLerTecla() {
+    int tecla = lerByte();
+    if (tecla == 27 && (espiarSemEsperar() == '[' || espiarSemEsperar() == 'O')) {
+        inicioTeclado++;
+        int proximo;
+        // Parâmetros até o byte final da sequência (0x40 a 0x7E)
+        while ((proximo = espiarSemEsperar()) != -1) {
+            inicioTeclado++;
+            if (proximo >= 0x40 && proximo <= 0x7E) break;
+        }
+        return TECLADO_TECLA_ESPECIAL;
+    }
+    return tecla;
+}
+
+/**
+ * @brief Indica, sem esperar, se já há teclas recebidas e ainda não lidas.
+ * * Usada para aplicar sequências coladas ou redirecionadas sem redesenhar a cada tecla.
+ */
+int tecladoTeclaPendente() {
+    if (inicioTeclado < fimTeclado) {
+        return 1;
+    }
+    if (fimDaEntrada) {
+        return 0;
+    }
+#ifdef _WIN32
+    return _isatty(0) && _kbhit();
+#else
+    struct pollfd entrada;
+    entrada.fd = STDIN_FILENO;
+    entrada.events = POLLIN;
+    return poll(&entrada, 1, 0) > 0 && (entrada.revents & POLLIN);
+#endif
+}
+
+/**
+ * @brief Lê uma linha inteira (até Enter), sem o terminador; o excesso é descartado.
+ * @param destino Recebe a linha (sempre terminada em '\0').
+ * @param tamanho O tamanho de 'destino'.
+ * @return 1 se uma linha foi lida, 0 no fim da entrada.
+ */
+int tecladoLerLinha(char* destino, size_t tamanho) {
+    size_t usados = 0;
+    int tecla;
+    while ((tecla = lerByte()) != EOF && tecla != '\n' && tecla != '\r') {
+        if (usados + 1 < tamanho) destino[usados++] = (char) tecla;
+    }
+    if (tecla == '\r' && espiarSemEsperar() == '\n') {
+        inicioTeclado++; // "\r\n" conta como um único Enter
+    }
+    destino[usados] = '\0';
+    return tecla != EOF || usados > 0;
+}
+
+/**
+ * @brief Espera o jogador pressionar Enter (uma única vez, mesmo depois de outras leituras).
+ */
+void tecladoEsperarEnter() {
+    char descarte[1];
+    tecladoLerLinha(descarte, sizeof(descarte));
+}
@@ -0,0 +1,17 @@
+#ifndef TECLADO_H
+#define TECLADO_H
+
+#include <stddef.h> // Para size_t
+
+// Valor devolvido por tecladoLerTecla para setas e teclas de função (sequências de escape)
+#define TECLADO_TECLA_ESPECIAL 0x100
+
+// Protótipos da camada de entrada (toda leitura da entrada padrão passa por aqui)
+void tecladoAtivarModoBruto();
+void tecladoRestaurarModo();
+int tecladoLerTecla();
+int tecladoTeclaPendente();
+int tecladoLerLinha(char* destino, size_t tamanho);
+void tecladoEsperarEnter();
+
+#endif // TECLADO_H
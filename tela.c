@@ -0,0 +1,215 @@
+#include "tela.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "instrumentacao.h" // Para medir o tempo gasto limpando a tela
+
+#ifdef _WIN32
+#include <windows.h> // Para GetConsoleMode/SetConsoleMode
+#include <io.h>      // Para _isatty
+#else
+#include <unistd.h>  // Para isatty
+#endif
+
+// Sequências ANSI usadas pela camada de exibição
+#define ANSI_LIMPAR_TELA "\033[H\033[2J"  // Cursor no início e apaga a tela inteira
+#define ANSI_APAGAR_LINHA "\033[K"        // Apaga do cursor até o fim da linha
+#define ANSI_APAGAR_ABAIXO "\033[J"       // Apaga do cursor até o fim da tela
+
+// Espaço reservado por linha para a sequência de posicionamento do cursor
+#define TAMANHO_MAXIMO_SEQUENCIA 24
+
+// Estado da camada de exibição
+static int ansiVerificado = 0;      // 1 depois que o suporte a ANSI foi testado
+static int ansiDisponivel = 0;      // 1 se a saída é um terminal que entende ANSI
+static int telaValida = 0;          // 1 se o terminal mostra exatamente 'quadroAnterior'
+static char* quadroAnterior = NULL; // Cópia do último conteúdo enviado
+static size_t tamanhoAnterior = 0;
+static size_t capacidadeAnterior = 0;
+static char* bufferSaida = NULL;    // Sequências montadas para a escrita única
+static size_t capacidadeSaida = 0;
+static FILE* saidaTela = NULL;      // Destino da escrita; NULL = saída padrão
+
+// Destino atual da camada de exibição
+static FILE* saida() {
+    return (saidaTela != NULL) ? saidaTela : stdout;
+}
+
+/**
+ * @brief Verifica (uma única vez) se a saída padrão é um terminal com suporte a ANSI.
+ * * No Windows tenta ativar o processamento de sequências virtuais do console.
+ * @return 1 se as sequências de controle de cursor podem ser usadas, 0 caso contrário.
+ */
+int telaSuportaAnsi() {
+    if (ansiVerificado) {
+        return ansiDisponivel;
+    }
+    ansiVerificado = 1;
+#ifdef _WIN32
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD modo = 0;
+    if (_isatty(_fileno(stdout)) && GetConsoleMode(console, &modo)) {
+        // ENABLE_VIRTUAL_TERMINAL_PROCESSING (0x0004) pode não existir em cabeçalhos antigos
+        ansiDisponivel = SetConsoleMode(console, modo | 0x0004) != 0;
+    }
+#else
+    ansiDisponivel = isatty(STDOUT_FILENO);
+#endif
+    return ansiDisponivel;
+}
+
+/**
+ * @brief Limpa a tela inteira sem criar processos (sem system("clear")).
+ * * A próxima chamada de telaAtualizar fará uma repintura completa.
+ */
+void telaLimpar() {
+    INSTR_INICIO(inicio);
+    if (telaSuportaAnsi()) {
+        fputs(ANSI_LIMPAR_TELA, saida());
+        fflush(saida());
+    }
+#ifdef _WIN32
+    else {
+        system("cls"); // Console antigo sem ANSI: único recurso disponível
+    }
+#endif
+    telaInvalidar();
+    INSTR_FIM(FASE_LIMPAR_TELA, inicio);
+}
+
+/**
+ * @brief Marca o conteúdo do terminal como desconhecido, forçando uma repintura completa.
+ * * Deve ser chamada sempre que algo for escrito na tela fora de telaAtualizar.
+ */
+void telaInvalidar() {
+    telaValida = 0;
+}
+
+// Garante 'necessario' bytes em um buffer dinâmico
+static int garantirCapacidade(char** buffer, size_t* capacidade, size_t necessario) {
+    if (*capacidade >= necessario) {
+        return 1;
+    }
+    size_t novaCapacidade = (*capacidade == 0) ? 1024 : *capacidade;
+    while (novaCapacidade < necessario) {
+        novaCapacidade *= 2;
+    }
+    char* novo = (char*) realloc(*buffer, novaCapacidade);
+    if (novo == NULL) {
+        perror("Erro ao alocar memoria para a tela");
+        return 0;
+    }
+    *buffer = novo;
+    *capacidade = novaCapacidade;
+    return 1;
+}
+
+// Conta as linhas (terminadas em '\n') de um conteúdo
+static size_t contarLinhas(const char* conteudo, size_t tamanho) {
+    size_t linhas = 0;
+    for (size_t i = 0; i < tamanho; i++) {
+        if (conteudo[i] == '\n') linhas++;
+    }
+    return linhas;
+}
+
+/**
+ * @brief Exibe 'conteudo' no topo da tela, reescrevendo apenas as linhas que mudaram.
+ * * Compara o conteúdo linha a linha com o último enviado e, para cada linha diferente,
+ * * posiciona o cursor nela e a reescreve. Tudo abaixo do conteúdo é apagado, e o cursor
+ * * fica logo após a última linha. Tudo é enviado com uma única escrita.
+ * * Sem ANSI (saída redirecionada ou console antigo) o conteúdo é escrito por inteiro.
+ * @param conteudo O texto da tela, com linhas terminadas em '\n'.
+ * @param tamanho O número de bytes de 'conteudo'.
+ */
+void telaAtualizar(const char* conteudo, size_t tamanho) {
+    if (!telaSuportaAnsi()) {
+        telaLimpar();
+        fwrite(conteudo, 1, tamanho, saida());
+        fflush(saida());
+        return;
+    }
+
+    size_t linhas = contarLinhas(conteudo, tamanho);
+    size_t necessario = tamanho + (linhas + 2) * TAMANHO_MAXIMO_SEQUENCIA + sizeof(ANSI_LIMPAR_TELA);
+    if (!garantirCapacidade(&bufferSaida, &capacidadeSaida, necessario)) {
+        return;
+    }
+
+    char* cursor = bufferSaida;
+    if (!telaValida) {
+        // Repintura completa: estado do terminal desconhecido
+        memcpy(cursor, ANSI_LIMPAR_TELA, sizeof(ANSI_LIMPAR_TELA) - 1);
+        cursor += sizeof(ANSI_LIMPAR_TELA) - 1;
+        memcpy(cursor, conteudo, tamanho);
+        cursor += tamanho;
+    } else {
+        // Atualização incremental: só as linhas diferentes do quadro anterior
+        size_t posNovo = 0, posAnterior = 0;
+        for (size_t linha = 1; posNovo < tamanho; linha++) {
+            const char* fimNovo = memchr(conteudo + posNovo, '\n', tamanho - posNovo);
+            size_t tamanhoNovo = (fimNovo ? (size_t)(fimNovo - conteudo) : tamanho) - posNovo;
+
+            size_t tamanhoVelho = 0;
+            int existeAnterior = posAnterior < tamanhoAnterior;
+            if (existeAnterior) {
+                const char* fimVelho = memchr(quadroAnterior + posAnterior, '\n', tamanhoAnterior - posAnterior);
+                tamanhoVelho = (fimVelho ? (size_t)(fimVelho - quadroAnterior) : tamanhoAnterior) - posAnterior;
+            }
+
+            if (!existeAnterior || tamanhoNovo != tamanhoVelho ||
+                memcmp(conteudo + posNovo, quadroAnterior + posAnterior, tamanhoNovo) != 0) {
+                cursor += sprintf(cursor, "\033[%lu;1H", (unsigned long)linha);
+                memcpy(cursor, conteudo + posNovo, tamanhoNovo);
+                cursor += tamanhoNovo;
+                memcpy(cursor, ANSI_APAGAR_LINHA, sizeof(ANSI_APAGAR_LINHA) - 1);
+                cursor += sizeof(ANSI_APAGAR_LINHA) - 1;
+            }
+
+            posNovo += tamanhoNovo + 1;
+            if (existeAnterior) {
+                posAnterior += tamanhoVelho + 1;
+            }
+        }
+        // Cursor logo após o conteúdo
+        cursor += sprintf(cursor, "\033[%lu;1H", (unsigned long)(linhas + 1));
+    }
+    // Apaga o que sobrou abaixo (linhas antigas, prompts e mensagens anteriores)
+    memcpy(cursor, ANSI_APAGAR_ABAIXO, sizeof(ANSI_APAGAR_ABAIXO) - 1);
+    cursor += sizeof(ANSI_APAGAR_ABAIXO) - 1;
+
+    fwrite(bufferSaida, 1, (size_t)(cursor - bufferSaida), saida());
+    fflush(saida());
+
+    // Guarda o conteúdo para a próxima comparação
+    if (garantirCapacidade(&quadroAnterior, &capacidadeAnterior, tamanho)) {
+        memcpy(quadroAnterior, conteudo, tamanho);
+        tamanhoAnterior = tamanho;
+        telaValida = 1;
+    }
+}
+
+/**
+ * @brief Redireciona a camada de exibição para outro arquivo (ex: um dispositivo nulo nos benchmarks).
+ * @param destino O destino da escrita; NULL volta para a saída padrão.
+ * @param usarAnsi 1 para usar a atualização incremental com ANSI, 0 para escrever quadros inteiros.
+ */
+void telaDefinirSaida(FILE* destino, int usarAnsi) {
+    saidaTela = destino;
+    ansiVerificado = (destino != NULL); // Com a saída padrão, o suporte volta a ser testado
+    ansiDisponivel = usarAnsi;
+    telaInvalidar();
+}
+
+/**
+ * @brief Libera os buffers da camada de exibição.
+ */
+void liberarTela() {
+    free(quadroAnterior);
+    free(bufferSaida);
+    quadroAnterior = NULL;
+    bufferSaida = NULL;
+    tamanhoAnterior = capacidadeAnterior = capacidadeSaida = 0;
+    telaValida = 0;
+}
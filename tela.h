@@ -0,0 +1,15 @@
+#ifndef TELA_H
+#define TELA_H
+
+#include <stddef.h> // Para size_t
+#include <stdio.h>  // Para FILE
+
+// Protótipos da camada de exibição com controle de cursor ANSI
+int telaSuportaAnsi();
+void telaLimpar();
+void telaInvalidar();
+void telaAtualizar(const char* conteudo, size_t tamanho);
+void telaDefinirSaida(FILE* destino, int usarAnsi);
+void liberarTela();
+
+#endif // TELA_H
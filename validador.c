@@ -0,0 +1,362 @@
+#include "validador.h"
+#include "historico.h"     // Para as partidas e o arquivo de movimentos
+#include "estado.h"        // Para as máscaras de bits
+#include "frame_stewart.h" // Para o mínimo de movimentos com k pinos
+#include "solucionador.h"  // Para gerar as gravações sintéticas
+#include "busca_paralela.h" // Para numeroDeNucleos
+#include "cronometro.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Operações atômicas (builtins do GCC/Clang, disponíveis também no MinGW)
+#define ATOMICO_SOMAR(ptr, valor) __atomic_fetch_add((ptr), (valor), __ATOMIC_RELAXED)
+
+// Movimentos examinados entre dois testes de parada (o laço interno não tem desvios)
+#define BLOCO_VALIDACAO 64
+
+// Marca de "ainda não aconteceu" nos índices calculados sem desvios
+#define NUNCA UINT64_MAX
+
+// Dados compartilhados pelas threads do validador
+typedef struct {
+    const GravacaoPartida* gravacoes;
+    ResultadoValidacao* resultados;
+    size_t quantidade;
+    size_t proxima; // Próxima gravação livre (avança por soma atômica: uma partida por tarefa)
+} ValidacaoCompartilhada;
+
+// Dados de uma thread do validador
+typedef struct {
+    ValidacaoCompartilhada* validacao;
+    size_t falhas;
+    unsigned long long movimentos;
+} TrabalhadorValidacao;
+
+/**
+ * @brief Valida uma gravação sobre o estado compacto, sem desvios por movimento.
+ * * Cada movimento é decodificado por tabela e aplicado com máscaras: a legalidade vira
+ * * uma máscara que anula a jogada, e o primeiro movimento ilegal e o momento em que a
+ * * torre chega ao destino são guardados com seleção por máscara. O único teste fica
+ * * no fim de cada bloco de BLOCO_VALIDACAO movimentos, para parar depois de um erro.
+ * @param gravacao A gravação a validar.
+ * @return A situação da gravação, o primeiro movimento ilegal e quando ela terminou.
+ */
+ResultadoValidacao validarGravacao(const GravacaoPartida* gravacao) {
+    ResultadoValidacao resultado = {VALIDACAO_PARAMETROS_INVALIDOS, -1, -1};
+    int numPinos = gravacao->numPinos;
+    if (numPinos < ESTADO_MIN_PINOS || numPinos > ESTADO_MAX_PINOS || gravacao->numDiscos < 1 ||
+        gravacao->numDiscos > ESTADO_MAX_DISCOS || gravacao->numMovimentos < 0 || gravacao->movimentos == NULL) {
+        return resultado;
+    }
+
+    // Tabelas de decodificação; códigos que não existem viram um movimento de um pino para ele mesmo (ilegal)
+    unsigned char origemDoCodigo[64] = {0};
+    unsigned char destinoDoCodigo[64] = {0};
+    for (int origem = 0; origem < numPinos; origem++) {
+        for (int destino = 0; destino < numPinos; destino++) {
+            if (origem == destino) continue;
+            int codigo = origem * (numPinos - 1) + (destino < origem ? destino : destino - 1);
+            origemDoCodigo[codigo] = (unsigned char) origem;
+            destinoDoCodigo[codigo] = (unsigned char) destino;
+        }
+    }
+    int bits = bitsPorMovimentoCompactado(numPinos);
+    unsigned mascaraCodigo = (1u << bits) - 1;
+
+    uint64_t pinos[ESTADO_MAX_PINOS] = {0};
+    uint64_t completa = estadoMascaraCompleta(gravacao->numDiscos);
+    pinos[0] = completa;
+    int pinoDestino = numPinos - 1;
+    const uint8_t* dados = gravacao->movimentos;
+    uint64_t total = (uint64_t) gravacao->numMovimentos;
+    uint64_t primeiroIlegal = NUNCA;
+    uint64_t concluidaEm = NUNCA;
+
+    for (uint64_t bloco = 0; bloco < total && primeiroIlegal == NUNCA; bloco += BLOCO_VALIDACAO) {
+        uint64_t fim = (total - bloco < BLOCO_VALIDACAO) ? total : bloco + BLOCO_VALIDACAO;
+        for (uint64_t i = bloco; i < fim; i++) {
+            uint64_t posicao = i * (uint64_t) bits;
+            unsigned janela = (unsigned) dados[posicao >> 3] | ((unsigned) dados[(posicao >> 3) + 1] << 8);
+            unsigned codigo = (janela >> (posicao & 7)) & mascaraCodigo;
+            int origem = origemDoCodigo[codigo];
+            int destino = destinoDoCodigo[codigo];
+
+            uint64_t discoOrigem = pinos[origem] & (0 - pinos[origem]);    // Topo da origem (0 se vazia)
+            uint64_t discoDestino = pinos[destino] & (0 - pinos[destino]); // Topo do destino (0 se vazio)
+            // Legal: origem não vazia e disco menor que o topo do destino (destino vazio: 0 - 1 = máximo).
+            // Com origem == destino os dois topos são iguais, e o movimento é ilegal.
+            uint64_t legal = (uint64_t)(discoOrigem != 0) & (uint64_t)(discoOrigem <= discoDestino - 1);
+            uint64_t aindaValida = (uint64_t)(primeiroIlegal == NUNCA);
+            uint64_t aplicar = 0 - (legal & aindaValida);
+            pinos[origem] ^= discoOrigem & aplicar;
+            pinos[destino] |= discoOrigem & aplicar;
+
+            uint64_t falhou = 0 - ((legal ^ 1) & aindaValida);
+            primeiroIlegal ^= (primeiroIlegal ^ i) & falhou;
+            uint64_t chegou = 0 - ((uint64_t)(pinos[pinoDestino] == completa) & (uint64_t)(concluidaEm == NUNCA));
+            concluidaEm ^= (concluidaEm ^ (i + 1)) & chegou;
+        }
+    }
+
+    resultado.primeiroIlegal = (primeiroIlegal == NUNCA) ? -1 : (long long) primeiroIlegal;
+    resultado.concluidaEm = (concluidaEm == NUNCA) ? -1 : (long long) concluidaEm;
+    if (primeiroIlegal != NUNCA) {
+        resultado.situacao = VALIDACAO_MOVIMENTO_ILEGAL;
+    } else if (concluidaEm == NUNCA) {
+        resultado.situacao = VALIDACAO_INCOMPLETA;
+    } else if (concluidaEm < total) {
+        resultado.situacao = VALIDACAO_CONCLUIDA_ANTES;
+    } else if ((uint64_t) gravacao->movimentosDesperdicados + movimentosOtimosMultiPinos(gravacao->numDiscos, numPinos)
+               != total) {
+        resultado.situacao = VALIDACAO_DESPERDICIO_DIVERGENTE;
+    } else {
+        resultado.situacao = VALIDACAO_OK;
+    }
+    return resultado;
+}
+
+// Corpo de cada thread: retira uma partida por vez até acabarem
+static void* validarPartidas(void* argumento) {
+    TrabalhadorValidacao* trabalhador = (TrabalhadorValidacao*) argumento;
+    ValidacaoCompartilhada* validacao = trabalhador->validacao;
+    while (1) {
+        size_t indice = ATOMICO_SOMAR(&validacao->proxima, 1);
+        if (indice >= validacao->quantidade) {
+            break;
+        }
+        validacao->resultados[indice] = validarGravacao(&validacao->gravacoes[indice]);
+        trabalhador->falhas += (validacao->resultados[indice].situacao != VALIDACAO_OK);
+        trabalhador->movimentos += (unsigned long long) validacao->gravacoes[indice].numMovimentos;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Valida muitas gravações em paralelo, uma partida por tarefa.
+ * @param gravacoes As gravações.
+ * @param quantidade O número de gravações.
+ * @param resultados Recebe o resultado de cada gravação (mesma ordem).
+ * @param numThreads Threads a usar (0 = uma por núcleo).
+ * @param estatisticas Recebe as medidas da validação (pode ser NULL).
+ * @return O número de gravações com falha.
+ */
+int validarGravacoes(const GravacaoPartida* gravacoes, size_t quantidade, ResultadoValidacao* resultados,
+                     int numThreads, EstatisticasValidacao* estatisticas) {
+    if (numThreads <= 0) numThreads = numeroDeNucleos();
+    if (numThreads > VALIDADOR_MAX_THREADS) numThreads = VALIDADOR_MAX_THREADS;
+
+    ValidacaoCompartilhada validacao = {gravacoes, resultados, quantidade, 0};
+    TrabalhadorValidacao trabalhadores[VALIDADOR_MAX_THREADS];
+    pthread_t threads[VALIDADOR_MAX_THREADS];
+    memset(trabalhadores, 0, sizeof(trabalhadores));
+    for (int t = 0; t < numThreads; t++) {
+        trabalhadores[t].validacao = &validacao;
+    }
+
+    double inicio = cronometroSegundos();
+    // A thread principal trabalha como a thread 0; as que não forem criadas têm o trabalho feito pelas outras
+    int criadas = 1;
+    for (int t = 1; t < numThreads; t++, criadas++) {
+        if (pthread_create(&threads[t], NULL, validarPartidas, &trabalhadores[t]) != 0) {
+            break;
+        }
+    }
+    validarPartidas(&trabalhadores[0]);
+    for (int t = 1; t < criadas; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    double segundos = cronometroSegundos() - inicio;
+
+    size_t falhas = 0;
+    unsigned long long movimentos = 0;
+    for (int t = 0; t < numThreads; t++) {
+        falhas += trabalhadores[t].falhas;
+        movimentos += trabalhadores[t].movimentos;
+    }
+    if (estatisticas != NULL) {
+        estatisticas->partidas = quantidade;
+        estatisticas->falhas = falhas;
+        estatisticas->movimentos = movimentos;
+        estatisticas->threads = criadas;
+        estatisticas->segundos = segundos;
+    }
+    return (int) falhas;
+}
+
+/**
+ * @brief Texto curto que descreve a situação de uma gravação.
+ */
+const char* descreverSituacaoValidacao(SituacaoValidacao situacao) {
+    switch (situacao) {
+        case VALIDACAO_OK: return "ok";
+        case VALIDACAO_MOVIMENTO_ILEGAL: return "movimento ilegal";
+        case VALIDACAO_INCOMPLETA: return "torre nao chega ao destino";
+        case VALIDACAO_CONCLUIDA_ANTES: return "torre chega ao destino antes do ultimo movimento";
+        case VALIDACAO_DESPERDICIO_DIVERGENTE: return "movimentos desperdicados nao conferem";
+        default: return "parametros invalidos";
+    }
+}
+
+// Imprime as medidas de uma validação em lote
+static void exibirEstatisticasValidacao(const EstatisticasValidacao* estatisticas) {
+    double segundos = (estatisticas->segundos > 0) ? estatisticas->segundos : 1e-9;
+    printf("%zu partidas, %llu movimentos, %d threads, %.6f s\n", estatisticas->partidas,
+           estatisticas->movimentos, estatisticas->threads, estatisticas->segundos);
+    printf("%.0f partidas/s, %.0f movimentos/s, %zu com falha\n", (double) estatisticas->partidas / segundos,
+           (double) estatisticas->movimentos / segundos, estatisticas->falhas);
+}
+
+// Contexto usado para juntar as partidas gravadas do histórico
+typedef struct {
+    const uint8_t* arquivo;      // Arquivo de movimentos inteiro
+    size_t tamanhoArquivo;
+    GravacaoPartida* gravacoes;
+    size_t* posicoes;            // Posição de cada gravação na lista do histórico
+    const Partida** partidas;
+    size_t quantidade;
+    size_t posicao;              // Posição da partida visitada (1 é a mais recente)
+    size_t semGravacao;
+} ColetaGravacoes;
+
+// Visitante de percorrerHistorico: guarda as partidas cuja gravação cabe no arquivo
+static int coletarGravacao(const Partida* partida, void* contexto) {
+    ColetaGravacoes* coleta = (ColetaGravacoes*) contexto;
+    coleta->posicao++;
+    size_t bytes = (partida->numMovimentos >= 0 && partida->numPinos >= ESTADO_MIN_PINOS &&
+                    partida->numPinos <= ESTADO_MAX_PINOS)
+                   ? bytesMovimentosCompactados(partida->numPinos, (size_t) partida->numMovimentos) : 0;
+    if (partida->deslocamentoMovimentos == SEM_MOVIMENTOS || coleta->arquivo == NULL ||
+        partida->deslocamentoMovimentos > coleta->tamanhoArquivo ||
+        bytes > coleta->tamanhoArquivo - (size_t) partida->deslocamentoMovimentos) {
+        coleta->semGravacao++;
+        return 0;
+    }
+    GravacaoPartida* gravacao = &coleta->gravacoes[coleta->quantidade];
+    gravacao->movimentos = coleta->arquivo + partida->deslocamentoMovimentos;
+    gravacao->numDiscos = partida->numDiscos;
+    gravacao->numPinos = partida->numPinos;
+    gravacao->numMovimentos = partida->numMovimentos;
+    gravacao->movimentosDesperdicados = partida->movimentosDesperdicados;
+    coleta->posicoes[coleta->quantidade] = coleta->posicao;
+    coleta->partidas[coleta->quantidade] = partida;
+    coleta->quantidade++;
+    return 0;
+}
+
+/**
+ * @brief Valida todas as partidas gravadas do histórico e imprime as que falharem.
+ * * As partidas são numeradas como em exibirHistorico (1 é a mais recente).
+ * @param numThreads Threads a usar (0 = uma por núcleo).
+ * @return 0 se todas as gravações forem válidas, 1 caso contrário ou em caso de erro.
+ */
+int executarValidador(int numThreads) {
+    inicializarHistoricoGlobal();
+    ColetaGravacoes coleta;
+    memset(&coleta, 0, sizeof(coleta));
+    size_t total = totalPartidasHistorico();
+    coleta.arquivo = lerArquivoDeMovimentos(&coleta.tamanhoArquivo);
+    coleta.gravacoes = (GravacaoPartida*) malloc((total > 0 ? total : 1) * sizeof(GravacaoPartida));
+    coleta.posicoes = (size_t*) malloc((total > 0 ? total : 1) * sizeof(size_t));
+    coleta.partidas = (const Partida**) malloc((total > 0 ? total : 1) * sizeof(const Partida*));
+    ResultadoValidacao* resultados = (ResultadoValidacao*) malloc((total > 0 ? total : 1) * sizeof(ResultadoValidacao));
+    int codigo = 1;
+    if (coleta.gravacoes == NULL || coleta.posicoes == NULL || coleta.partidas == NULL || resultados == NULL) {
+        perror("Erro ao alocar memoria para o validador");
+    } else {
+        percorrerHistorico(coletarGravacao, &coleta);
+        EstatisticasValidacao estatisticas;
+        validarGravacoes(coleta.gravacoes, coleta.quantidade, resultados, numThreads, &estatisticas);
+        for (size_t i = 0; i < coleta.quantidade; i++) {
+            if (resultados[i].situacao == VALIDACAO_OK) continue;
+            printf("Partida %zu (%s, %d discos, %d pinos, %d movimentos): %s", coleta.posicoes[i],
+                   coleta.partidas[i]->nomeJogador, coleta.partidas[i]->numDiscos, coleta.partidas[i]->numPinos,
+                   coleta.partidas[i]->numMovimentos, descreverSituacaoValidacao(resultados[i].situacao));
+            if (resultados[i].primeiroIlegal >= 0) {
+                printf(" (indice %lld)", resultados[i].primeiroIlegal);
+            } else if (resultados[i].situacao == VALIDACAO_CONCLUIDA_ANTES) {
+                printf(" (apos %lld movimentos)", resultados[i].concluidaEm);
+            }
+            printf("\n");
+        }
+        if (coleta.semGravacao > 0) {
+            printf("%zu partidas sem movimentos gravados (ignoradas)\n", coleta.semGravacao);
+        }
+        exibirEstatisticasValidacao(&estatisticas);
+        codigo = (estatisticas.falhas > 0) ? 1 : 0;
+    }
+    free(resultados);
+    free(coleta.partidas);
+    free(coleta.posicoes);
+    free(coleta.gravacoes);
+    free((void*) coleta.arquivo);
+    liberarHistoricoGlobal();
+    return codigo;
+}
+
+/**
+ * @brief Mede a vazão do validador com partidas ótimas de 3 pinos geradas na hora.
+ * * Uma em cada 97 partidas recebe um movimento invertido no meio (sempre ilegal),
+ * * para conferir que o validador aponta o índice certo.
+ * @param numPartidas Quantas partidas validar.
+ * @param numDiscos Discos de cada partida.
+ * @param numThreads Threads a usar (0 = uma por núcleo).
+ * @return 0 se as falhas encontradas forem exatamente as esperadas, 1 caso contrário.
+ */
+int executarValidadorSintetico(size_t numPartidas, int numDiscos, int numThreads) {
+    if (numPartidas == 0 || numDiscos < 1 || numDiscos > 24) {
+        fprintf(stderr, "Erro: use pelo menos 1 partida e de 1 a 24 discos.\n");
+        return 1;
+    }
+    size_t total = (size_t) totalMovimentosOtimos(numDiscos);
+    size_t meio = total / 2;
+    Movimento* sequencia = (Movimento*) malloc(total * sizeof(Movimento));
+    HistoricoMovimentos* correta = criarHistoricoMovimentos(3);
+    HistoricoMovimentos* corrompida = criarHistoricoMovimentos(3);
+    GravacaoPartida* gravacoes = (GravacaoPartida*) malloc(numPartidas * sizeof(GravacaoPartida));
+    ResultadoValidacao* resultados = (ResultadoValidacao*) malloc(numPartidas * sizeof(ResultadoValidacao));
+    int codigo = 1;
+    if (sequencia == NULL || correta == NULL || corrompida == NULL || gravacoes == NULL || resultados == NULL) {
+        perror("Erro ao alocar memoria para o validador");
+    } else {
+        gerarMovimentosOtimos(numDiscos, 0, 2, 0, sequencia, total);
+        for (size_t i = 0; i < total; i++) {
+            registrarMovimento(correta, sequencia[i].origem, sequencia[i].destino);
+            // O inverso de um movimento legal, feito antes dele, é sempre ilegal
+            if (i == meio) registrarMovimento(corrompida, sequencia[i].destino, sequencia[i].origem);
+            else registrarMovimento(corrompida, sequencia[i].origem, sequencia[i].destino);
+        }
+        if (correta->movimentos == NULL || corrompida->movimentos == NULL) {
+            fprintf(stderr, "Erro: Nao foi possivel gravar as partidas sinteticas.\n");
+        } else {
+            size_t esperadas = 0;
+            for (size_t p = 0; p < numPartidas; p++) {
+                int corromper = (p % 97 == 96);
+                esperadas += corromper;
+                gravacoes[p].movimentos = corromper ? corrompida->movimentos : correta->movimentos;
+                gravacoes[p].numDiscos = numDiscos;
+                gravacoes[p].numPinos = 3;
+                gravacoes[p].numMovimentos = (int) total;
+                gravacoes[p].movimentosDesperdicados = 0;
+            }
+            EstatisticasValidacao estatisticas;
+            validarGravacoes(gravacoes, numPartidas, resultados, numThreads, &estatisticas);
+            size_t indicesCertos = 0;
+            for (size_t p = 0; p < numPartidas; p++) {
+                indicesCertos += (resultados[p].situacao == VALIDACAO_MOVIMENTO_ILEGAL &&
+                                  resultados[p].primeiroIlegal == (long long) meio);
+            }
+            printf("Validador sintetico: %d discos, %zu movimentos por partida\n", numDiscos, total);
+            exibirEstatisticasValidacao(&estatisticas);
+            printf("Falhas esperadas: %zu; apontadas no movimento %zu: %zu\n", esperadas, meio, indicesCertos);
+            codigo = (estatisticas.falhas == esperadas && indicesCertos == esperadas) ? 0 : 1;
+        }
+    }
+    free(resultados);
+    free(gravacoes);
+    liberarHistoricoMovimentos(corrompida);
+    liberarHistoricoMovimentos(correta);
+    free(sequencia);
+    return codigo;
+}
@@ -0,0 +1,54 @@
+#ifndef VALIDADOR_H
+#define VALIDADOR_H
+
+#include <stddef.h> // Para size_t
+#include <stdint.h> // Para uint8_t
+
+// Maior número de threads do validador
+#define VALIDADOR_MAX_THREADS 64
+
+// Uma gravação a validar: os movimentos compactados e o que o histórico diz sobre eles.
+// O buffer precisa ter pelo menos 1 byte legível além do último código (ver lerArquivoDeMovimentos).
+typedef struct {
+    const uint8_t* movimentos;
+    int numDiscos;
+    int numPinos;
+    int numMovimentos;
+    int movimentosDesperdicados;
+} GravacaoPartida;
+
+// Situação de uma gravação depois da validação
+typedef enum {
+    VALIDACAO_OK,                    // Todos os movimentos legais e a partida termina no último movimento
+    VALIDACAO_MOVIMENTO_ILEGAL,      // Algum movimento viola as regras (ver primeiroIlegal)
+    VALIDACAO_INCOMPLETA,            // Os movimentos não levam a torre ao último pino
+    VALIDACAO_CONCLUIDA_ANTES,       // A torre chega ao destino antes de numMovimentos (ver concluidaEm)
+    VALIDACAO_DESPERDICIO_DIVERGENTE, // movimentosDesperdicados não é numMovimentos menos o mínimo
+    VALIDACAO_PARAMETROS_INVALIDOS   // Discos, pinos ou movimentos fora dos limites
+} SituacaoValidacao;
+
+// Resultado da validação de uma gravação
+typedef struct {
+    SituacaoValidacao situacao;
+    long long primeiroIlegal; // Índice (a partir de 0) do primeiro movimento ilegal, ou -1
+    long long concluidaEm;    // Movimentos até a torre chegar ao destino, ou -1 se não chegou
+} ResultadoValidacao;
+
+// Medidas de uma validação em lote
+typedef struct {
+    size_t partidas;         // Gravações validadas
+    size_t falhas;           // Gravações com situação diferente de VALIDACAO_OK
+    unsigned long long movimentos; // Movimentos examinados
+    int threads;             // Threads usadas
+    double segundos;         // Tempo da validação
+} EstatisticasValidacao;
+
+// Protótipos do validador de gravações
+ResultadoValidacao validarGravacao(const GravacaoPartida* gravacao);
+int validarGravacoes(const GravacaoPartida* gravacoes, size_t quantidade, ResultadoValidacao* resultados,
+                     int numThreads, EstatisticasValidacao* estatisticas);
+const char* descreverSituacaoValidacao(SituacaoValidacao situacao);
+int executarValidador(int numThreads);
+int executarValidadorSintetico(size_t numPartidas, int numDiscos, int numThreads);
+
+#endif // VALIDADOR_H